@@ -1,414 +1,1321 @@
-#include <iostream>
-#include <fstream>
-#include <string>
-#include <vector>
-#include <sstream>
-#include <time.h>
-#include <random>
-#include <unordered_set>
-#include <algorithm>
-using namespace std;
-
-
-class MaxCliqueTabuSearch
-{
-public:
-    static int GetRandom(int a, int b)
-    {
-        static mt19937 generator;
-        uniform_int_distribution<int> uniform(a, b);
-        return uniform(generator);
-    }
-
-    void ReadGraphFile(string filename)
-    {
-        ifstream fin(filename);
-        string line;
-        int vertices = 0, edges = 0;
-        while (getline(fin, line))
-        {
-            if (line[0] == 'c')
-            {
-                continue;
-            }
-
-            stringstream line_input(line);
-            char command;
-            if (line[0] == 'p')
-            {
-                string type;
-                line_input >> command >> type >> vertices >> edges;
-                neighbour_sets.resize(vertices);
-                qco.resize(vertices);
-                index.resize(vertices, -1);
-                non_neighbours.resize(vertices);
-            }
-            else
-            {
-                int start, finish;
-                line_input >> command >> start >> finish;
-                // Edges in DIMACS file can be repeated, but it is not a problem for our sets
-                neighbour_sets[start - 1].insert(finish - 1);
-                neighbour_sets[finish - 1].insert(start - 1);
-            }
-        }
-        for (int i = 0; i < vertices; ++i)
-        {
-            for (int j = 0; j < vertices; ++j)
-            {
-                if (neighbour_sets[i].count(j) == 0 && i != j)
-                    non_neighbours[i].insert(j);
-            }
-        }
-    }
-
-    void RunSearch(int starts, int randomization)
-    {
-        for (int iter = 0; iter < starts; ++iter)
-        {
-            ClearClique();
-            for (size_t i = 0; i < neighbour_sets.size(); ++i)
-            {
-                qco[i] = i;
-                index[i] = i;
-            }
-            RunInitialHeuristic(randomization);
-            c_border = q_border;
-            int swaps = 0;
-            while (swaps < 100)
-            {
-                if (!Move())
-                {
-                    if (!Swap1To1())
-                    {
-                        break;
-                    }
-                    else
-                    {
-                        ++swaps;
-                    }
-                }
-            }
-            if (q_border > best_clique.size())
-            {
-                best_clique.clear();
-                for (int i = 0; i < q_border; ++i)
-                    best_clique.insert(qco[i]);
-            }
-        }
-    }
-
-    const unordered_set<int>& GetClique()
-    {
-        return best_clique;
-    }
-
-    bool Check()
-    {
-        for (int i : best_clique)
-        {
-            for (int j : best_clique)
-            {
-                if (i != j && neighbour_sets[i].count(j) == 0)
-                {
-                    cout << "Returned subgraph is not a clique\n";
-                    return false;
-                }
-            }
-        }
-        return true;
-    }
-
-    void ClearClique()
-    {
-        best_clique.clear();
-        q_border = 0;
-        c_border = 0;
-    }
-
-private:
-    int ComputeTightness(int vertex)
-    {
-        int tightness = 0;
-        for (int i = 0; i < q_border; ++i)
-        {
-            if (neighbour_sets[qco[i]].count(vertex) == 0)
-                ++tightness;
-        }
-        return tightness;
-    }
-
-    void SwapVertices(int vertex, int border)
-    {
-        int vertex_at_border = qco[border];
-        swap(qco[index[vertex]], qco[border]);
-        swap(index[vertex], index[vertex_at_border]);
-    }
-
-    void InsertToClique(int i)
-    {
-        for (int j : non_neighbours[i])
-        {
-            if (ComputeTightness(j) == 0)
-            {
-                --c_border;
-                SwapVertices(j, c_border);
-            }
-        }
-        SwapVertices(i, q_border);
-        ++q_border;
-    }
-
-    void RemoveFromClique(int k)
-    {
-        for (int j : non_neighbours[k])
-        {
-            if (ComputeTightness(j) == 1)
-            {
-                SwapVertices(j, c_border);
-                c_border++;
-            }
-        }
-        --q_border;
-        SwapVertices(k, q_border);
-    }
-
-    bool Swap1To1()
-    {
-        int st = GetRandom(0, q_border - 1);
-        for (int counter = 0; counter < q_border; ++counter)
-        {
-            int vertex_index = (counter + st) % q_border;
-            int vertex = qco[vertex_index];
-            vector<int> L;
-            for (int i : non_neighbours[vertex])
-            {
-                if (ComputeTightness(i) == 1)
-                {
-                    L.push_back(i);
-                }
-            }
-            if (L.empty())
-                continue;
-            int index_in_l = GetRandom(0, L.size() - 1);
-            int change = L[index_in_l];
-            RemoveFromClique(vertex);
-            InsertToClique(change);
-            return true;
-        }
-        return false;
-    }
-
-    bool Move()
-    {
-        if (c_border == q_border)
-            return false;
-        int index_in_qco = GetRandom(q_border, c_border - 1);
-        int vertex = qco[index_in_qco];
-        InsertToClique(vertex);
-        return true;
-    }
-
-    void RunInitialHeuristic(int randomization)
-    {
-        static mt19937 generator;
-        vector<int> candidates(neighbour_sets.size());
-        for (size_t i = 0; i < neighbour_sets.size(); ++i)
-        {
-            candidates[i] = i;
-        }
-        shuffle(candidates.begin(), candidates.end(), generator);
-        while (!candidates.empty())
-        {
-            int last = candidates.size() - 1;
-            int rnd = GetRandom(0, min(randomization - 1, last));
-            int vertex = candidates[rnd];
-            SwapVertices(vertex, q_border);
-            ++q_border;
-            for (int c = 0; c < candidates.size(); ++c)
-            {
-                int candidate = candidates[c];
-                if (neighbour_sets[vertex].count(candidate) == 0)
-                {
-                    // Move the candidate to the end and pop it
-                    swap(candidates[c], candidates[candidates.size() - 1]);
-                    candidates.pop_back();
-                    --c;
-                }
-            }
-            shuffle(candidates.begin(), candidates.end(), generator);
-        }
-    }
-
-private:
-    vector<unordered_set<int>> neighbour_sets;
-    vector<unordered_set<int>> non_neighbours;
-    unordered_set<int> best_clique;
-    vector<int> qco;
-    vector<int> index;
-    int q_border = 0;
-    int c_border = 0;
-};
-
-
-class BnBSolver
-{
-public:
-    void ReadGraphFile(string filename)
-    {
-        ifstream fin(filename);
-        string line;
-        file = filename;
-        int vert = 0, edges = 0;
-        while (getline(fin, line))
-        {
-            if (line[0] == 'c')
-            {
-                continue;
-            }
-            if (line[0] == 'p')
-            {
-                stringstream s(line);
-                char c;
-                string in;
-                s >> c >> in >> vert >> edges;
-                neighbours.resize(vert);
-            }
-            else
-            {
-                stringstream s(line);
-                char c;
-                int st, fn;
-                s >> c >> st >> fn;
-                neighbours[st - 1].insert(fn - 1);
-                neighbours[fn - 1].insert(st - 1);
-            }
-        }
-    }
-
-    void RunBnB()
-    {
-        MaxCliqueTabuSearch st;
-        st.ReadGraphFile(file);
-        st.RunSearch(1, 10);
-        best_clique = st.GetClique();
-        vector<int> candidates(neighbours.size());
-        for (size_t i = 0; i < neighbours.size(); ++i)
-        {
-            candidates[i] = i;
-        }
-        static mt19937 generator;
-        shuffle(candidates.begin(), candidates.end(), generator);
-        BnBRecursion(candidates);
-    }
-
-    const unordered_set<int>& GetClique()
-    {
-        return best_clique;
-    }
-
-    bool Check()
-    {
-        for (int i : clique)
-        {
-            for (int j : clique)
-            {
-                if (i != j && neighbours[i].count(j) == 0)
-                {
-                    cout << "Returned subgraph is not clique\n";
-                    return false;
-                }
-            }
-        }
-        return true;
-    }
-
-    void ClearClique()
-    {
-        best_clique.clear();
-        clique.clear();
-    }
-
-private:
-    void BnBRecursion(const vector<int>& candidates)
-    {
-        if (candidates.empty())
-        {
-            if (clique.size() > best_clique.size())
-            {
-                best_clique = clique;
-            }
-            return;
-        }
-
-        if (clique.size() + candidates.size() <= best_clique.size())
-            return;
-
-        for (size_t c = 0; c < candidates.size(); ++c)
-        {
-            vector<int> new_candidates;
-            new_candidates.reserve(candidates.size());
-            for (size_t i = c + 1; i < candidates.size(); ++i)
-            {
-                if (neighbours[candidates[c]].count(candidates[i]) != 0)
-                    new_candidates.push_back(candidates[i]);
-            }
-            clique.insert(candidates[c]);
-            BnBRecursion(new_candidates);
-            clique.erase(candidates[c]);
-        }
-    }
-
-private:
-    vector<unordered_set<int>> neighbours;
-    unordered_set<int> best_clique;
-    unordered_set<int> clique;
-    string file;
-};
-
-string GetProjectFolder() {
-    string path = __FILE__;
-    size_t found = path.find_last_of("\\/");
-
-    // get current project folder
-    string folderPath = path.substr(0, found);
-    return folderPath;
-}
-
-int main()
-{
-    string projFolder = GetProjectFolder();
-    string cliqueF = projFolder + "\\..\\cliques\\";
-
-    ios_base::sync_with_stdio(false);
-    cin.tie(nullptr);
-    vector<string> files = {
-        cliqueF + "brock200_1.clq", cliqueF + "brock200_2.clq", cliqueF + "brock200_3.clq", cliqueF + "brock200_4.clq",
-        cliqueF + "C125.9.clq",
-        cliqueF + "gen200_p0.9_44.clq", cliqueF + "gen200_p0.9_55.clq",
-        cliqueF + "hamming8-4.clq",
-        cliqueF + "johnson16-2-4.clq", cliqueF + "johnson8-2-4.clq",
-        cliqueF + "keller4.clq",
-        cliqueF + "MANN_a27.clq", cliqueF + "MANN_a9.clq",
-        cliqueF + "p_hat1000-1.clq", cliqueF + "p_hat1500-1.clq", cliqueF + "p_hat300-3.clq",
-        cliqueF + "san1000.clq", cliqueF + "sanr200_0.9.clq"
-    };
-    ofstream fout("clique_bnb.csv");
-    fout << "File; Clique; Time (sec)\n";
-    for (string file : files)
-    {
-        BnBSolver problem;
-        problem.ReadGraphFile(file);
-        problem.ClearClique();
-        clock_t start = clock();
-        problem.RunBnB();
-        if (!problem.Check())
-        {
-            cout << "*** WARNING: incorrect clique ***\n";
-            fout << "*** WARNING: incorrect clique ***\n";
-        }
-        fout << file << "; " << problem.GetClique().size() << "; " << double(clock() - start) / CLOCKS_PER_SEC << '\n';
-        cout << file << ", result - " << problem.GetClique().size() << ", time - " << double(clock() - start) / CLOCKS_PER_SEC << '\n';
-    }
-    return 0;
-}
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <time.h>
+#include <random>
+#include <unordered_set>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <queue>
+#include <chrono>
+#include <thread>
+#include "csr_graph.h"
+#include "dimacs.h"
+#include "instances.h"
+#include "degeneracy.h"
+#include "reduction.h"
+#include "relabel.h"
+#include "bitset.h"
+#include "maximal_cliques.h"
+#include "vertex_weights.h"
+#include "independent_set.h"
+#include "symmetry.h"
+using namespace std;
+
+
+class MaxCliqueTabuSearch
+{
+public:
+    static int GetRandom(int a, int b)
+    {
+        static mt19937 generator(RunSeed());
+        uniform_int_distribution<int> uniform(a, b);
+        return uniform(generator);
+    }
+
+    // Unweighted, a weighted run sets the weights with SetVertexWeights()
+    void ReadGraphFile(string filename)
+    {
+        DimacsGraph graph = ReadDimacsGraph(filename);
+        neighbour_sets = move(graph.neighbour_sets);
+        int vertices = neighbour_sets.size();
+        original_ids.resize(vertices);
+        iota(original_ids.begin(), original_ids.end(), 0);
+        weights = vertex_weights;
+        reduction_stats.vertices_before = reduction_stats.vertices_after = vertices;
+        for (const unordered_set<int>& neighbours : neighbour_sets)
+            reduction_stats.edges_before += neighbours.size();
+        reduction_stats.edges_before /= 2;
+        reduction_stats.edges_after = reduction_stats.edges_before;
+        BuildSearchState();
+    }
+
+    // Vertex weights in file ids (see vertex_weights.h), from then on the search maximises the
+    // clique weight. Can be called after relabelling or reduction.
+    void SetVertexWeights(vector<int> file_weights)
+    {
+        vertex_weights = move(file_weights);
+        weights = SelectVertexWeights(vertex_weights, original_ids);
+        best_weight = CliqueWeight(vertex_weights, best_clique);
+    }
+
+    bool IsWeighted()
+    {
+        return !vertex_weights.empty();
+    }
+
+    // Vertex weights in file ids, empty for an unweighted graph
+    const vector<int>& GetVertexWeights()
+    {
+        return vertex_weights;
+    }
+
+    // Continues on the subgraph of the vertices that can be in a clique larger than the best one.
+    // The best clique is kept in original ids and Check() runs against the original graph.
+    void ReduceGraph()
+    {
+        CliqueReduction reduction = IsWeighted() ? ReduceForWeightedClique(neighbour_sets, weights, best_weight)
+            : ReduceForClique(neighbour_sets, best_clique.size());
+        reduction_stats.vertices_after = reduction.stats.vertices_after;
+        reduction_stats.edges_after = reduction.stats.edges_after;
+        ReplaceGraph(move(reduction.neighbour_sets), reduction.original_ids);
+    }
+
+    // Renumbers the vertices for locality (see relabel.h), the best clique stays in original ids
+    void RelabelVertices(VertexRelabelling relabelling)
+    {
+        if (relabelling == VertexRelabelling::None)
+            return;
+        vector<int> order = ComputeRelabelling(BuildCsrGraph(neighbour_sets), relabelling);
+        ReplaceGraph(RelabelNeighbourSets(neighbour_sets, order), order);
+    }
+
+    const ReductionStats& GetReductionStats()
+    {
+        return reduction_stats;
+    }
+
+    void RunSearch(int starts, int randomization)
+    {
+        for (int iter = 0; iter < starts; ++iter)
+        {
+            ClearClique();
+            for (size_t i = 0; i < neighbour_sets.size(); ++i)
+            {
+                qco[i] = i;
+                index[i] = i;
+            }
+            RunInitialHeuristic(randomization);
+            c_border = q_border;
+            int swaps = 0;
+            while (swaps < 100)
+            {
+                if (!Move())
+                {
+                    if (!Swap1To1())
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        ++swaps;
+                    }
+                }
+            }
+            long long weight = CliqueWeight(weights, vector<int>(qco.begin(), qco.begin() + q_border));
+            if (weight > best_weight)
+            {
+                best_clique.clear();
+                for (int i = 0; i < q_border; ++i)
+                    best_clique.insert(original_ids[qco[i]]);
+                best_weight = weight;
+            }
+            // No clique is larger than degeneracy + 1, the rest of the starts cannot improve
+            if (!IsWeighted() && int(best_clique.size()) >= degeneracy + 1)
+                break;
+        }
+    }
+
+    const unordered_set<int>& GetClique()
+    {
+        return best_clique;
+    }
+
+    // Clique weight, the size for an unweighted graph
+    long long GetCliqueWeight()
+    {
+        return best_weight;
+    }
+
+    bool Check()
+    {
+        const vector<unordered_set<int>>& graph = original_neighbour_sets.empty() ? neighbour_sets : original_neighbour_sets;
+        for (int i : best_clique)
+        {
+            for (int j : best_clique)
+            {
+                if (i != j && graph[i].count(j) == 0)
+                {
+                    cout << "Returned subgraph is not a clique\n";
+                    return false;
+                }
+            }
+        }
+        if (CliqueWeight(vertex_weights, best_clique) != best_weight)
+        {
+            cout << "Clique weight does not match its vertices\n";
+            return false;
+        }
+        return true;
+    }
+
+    // Empties the working clique, the best one found so far is kept across starts
+    void ClearClique()
+    {
+        q_border = 0;
+        c_border = 0;
+    }
+
+private:
+    // Switches to a graph whose vertex i is vertex ids[i] of the current one
+    void ReplaceGraph(vector<unordered_set<int>> graph, const vector<int>& ids)
+    {
+        vector<int> composed(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i)
+            composed[i] = original_ids[ids[i]];
+        if (original_neighbour_sets.empty())
+            original_neighbour_sets = move(neighbour_sets);
+        neighbour_sets = move(graph);
+        original_ids = move(composed);
+        weights = SelectVertexWeights(weights, ids);
+        BuildSearchState();
+    }
+
+    // Search arrays and the degeneracy bound for the current (possibly reduced) graph
+    void BuildSearchState()
+    {
+        int vertices = neighbour_sets.size();
+        qco.assign(vertices, 0);
+        index.assign(vertices, -1);
+        non_neighbours.assign(vertices, unordered_set<int>());
+        degeneracy = ComputeCoreDecomposition(BuildCsrGraph(neighbour_sets)).degeneracy;
+        for (int i = 0; i < vertices; ++i)
+        {
+            for (int j = 0; j < vertices; ++j)
+            {
+                if (neighbour_sets[i].count(j) == 0 && i != j)
+                    non_neighbours[i].insert(j);
+            }
+        }
+    }
+
+    int ComputeTightness(int vertex)
+    {
+        int tightness = 0;
+        for (int i = 0; i < q_border; ++i)
+        {
+            if (neighbour_sets[qco[i]].count(vertex) == 0)
+                ++tightness;
+        }
+        return tightness;
+    }
+
+    void SwapVertices(int vertex, int border)
+    {
+        int vertex_at_border = qco[border];
+        swap(qco[index[vertex]], qco[border]);
+        swap(index[vertex], index[vertex_at_border]);
+    }
+
+    void InsertToClique(int i)
+    {
+        for (int j : non_neighbours[i])
+        {
+            if (ComputeTightness(j) == 0)
+            {
+                --c_border;
+                SwapVertices(j, c_border);
+            }
+        }
+        SwapVertices(i, q_border);
+        ++q_border;
+    }
+
+    void RemoveFromClique(int k)
+    {
+        for (int j : non_neighbours[k])
+        {
+            if (ComputeTightness(j) == 1)
+            {
+                SwapVertices(j, c_border);
+                c_border++;
+            }
+        }
+        --q_border;
+        SwapVertices(k, q_border);
+    }
+
+    // Weighted swap (FastWClq-style score): the 1-tight vertex and the clique vertex it replaces with
+    // the largest weight gain, ties broken at random (GainChoice); swaps that lose weight are not made
+    bool WeightedSwap1To1()
+    {
+        int best_out = -1, best_in = -1;
+        GainChoice choice(0);
+        for (int counter = 0; counter < q_border; ++counter)
+        {
+            int vertex = qco[counter];
+            for (int i : non_neighbours[vertex])
+            {
+                long long gain = weights[i] - weights[vertex];
+                if (!choice.CanTake(gain) || ComputeTightness(i) != 1)
+                    continue;
+                if (choice.Offer(gain, [](int ties) { return GetRandom(1, ties); }))
+                {
+                    best_out = vertex;
+                    best_in = i;
+                }
+            }
+        }
+        if (best_out == -1)
+            return false;
+        RemoveFromClique(best_out);
+        InsertToClique(best_in);
+        return true;
+    }
+
+    bool Swap1To1()
+    {
+        if (IsWeighted())
+            return WeightedSwap1To1();
+        int st = GetRandom(0, q_border - 1);
+        for (int counter = 0; counter < q_border; ++counter)
+        {
+            int vertex_index = (counter + st) % q_border;
+            int vertex = qco[vertex_index];
+            vector<int> L;
+            for (int i : non_neighbours[vertex])
+            {
+                if (ComputeTightness(i) == 1)
+                {
+                    L.push_back(i);
+                }
+            }
+            if (L.empty())
+                continue;
+            int index_in_l = GetRandom(0, L.size() - 1);
+            int change = L[index_in_l];
+            RemoveFromClique(vertex);
+            InsertToClique(change);
+            return true;
+        }
+        return false;
+    }
+
+    bool Move()
+    {
+        if (c_border == q_border)
+            return false;
+        if (IsWeighted())
+        {
+            // Every free vertex is adjacent to the whole clique, the heaviest one is the best add
+            int heaviest = q_border;
+            for (int i = q_border + 1; i < c_border; ++i)
+            {
+                if (weights[qco[i]] > weights[qco[heaviest]])
+                    heaviest = i;
+            }
+            InsertToClique(qco[heaviest]);
+            return true;
+        }
+        int index_in_qco = GetRandom(q_border, c_border - 1);
+        int vertex = qco[index_in_qco];
+        InsertToClique(vertex);
+        return true;
+    }
+
+    void RunInitialHeuristic(int randomization)
+    {
+        static mt19937 generator(RunSeed());
+        vector<int> candidates(neighbour_sets.size());
+        for (size_t i = 0; i < neighbour_sets.size(); ++i)
+        {
+            candidates[i] = i;
+        }
+        shuffle(candidates.begin(), candidates.end(), generator);
+        while (!candidates.empty())
+        {
+            // A weighted search picks among the `randomization` heaviest candidates
+            if (IsWeighted())
+                stable_sort(candidates.begin(), candidates.end(), [&](int a, int b) { return weights[a] > weights[b]; });
+            int last = candidates.size() - 1;
+            int rnd = GetRandom(0, min(randomization - 1, last));
+            int vertex = candidates[rnd];
+            SwapVertices(vertex, q_border);
+            ++q_border;
+            for (int c = 0; c < candidates.size(); ++c)
+            {
+                int candidate = candidates[c];
+                if (neighbour_sets[vertex].count(candidate) == 0)
+                {
+                    // Move the candidate to the end and pop it
+                    swap(candidates[c], candidates[candidates.size() - 1]);
+                    candidates.pop_back();
+                    --c;
+                }
+            }
+            shuffle(candidates.begin(), candidates.end(), generator);
+        }
+    }
+
+private:
+    vector<unordered_set<int>> neighbour_sets;
+    vector<unordered_set<int>> non_neighbours;
+    unordered_set<int> best_clique;
+    long long best_weight = 0;
+    // Empty for an unweighted graph; vertex_weights is in file ids, weights in current ids
+    vector<int> vertex_weights;
+    vector<int> weights;
+    vector<int> qco;
+    vector<int> index;
+    int q_border = 0;
+    int c_border = 0;
+    int degeneracy = 0;
+    vector<unordered_set<int>> original_neighbour_sets;
+    vector<int> original_ids;
+    ReductionStats reduction_stats;
+};
+
+
+// Answer of BnBSolver::DecideClique(k). A witness is a clique of exactly k vertices in original
+// ids; without one, bound names what proved that no k-clique exists and nodes is the search effort.
+struct CliqueDecision
+{
+    int k = 0;
+    bool found = false;
+    vector<int> witness;
+    long long nodes = 0;
+    string bound;
+};
+
+class BnBSolver
+{
+public:
+    void ReadGraphFile(string filename, bool weighted = false)
+    {
+        file = filename;
+        DimacsGraph graph = ReadDimacsGraph(filename);
+        neighbours = move(graph.neighbour_sets);
+        int vert = neighbours.size();
+        // Without weighted the search stays maximum cardinality, "n" lines of the file included
+        if (weighted)
+            vertex_weights = ChooseVertexWeights(filename, move(graph.vertex_weights), vert);
+        original_ids.resize(vert);
+        iota(original_ids.begin(), original_ids.end(), 0);
+        weights = vertex_weights;
+        reduction_stats.vertices_before = reduction_stats.vertices_after = vert;
+        for (const unordered_set<int>& n : neighbours)
+            reduction_stats.edges_before += n.size();
+        reduction_stats.edges_before /= 2;
+        reduction_stats.edges_after = reduction_stats.edges_before;
+    }
+
+    bool IsWeighted()
+    {
+        return !vertex_weights.empty();
+    }
+
+    void RunBnB()
+    {
+        if (IsWeighted())
+        {
+            RunWeightedBnB();
+            return;
+        }
+        RunIncumbentSearch();
+        // Only vertices with core number at least the incumbent size survive the reduction
+        ReduceGraph(best_clique.size());
+        // Degeneracy order: every vertex has at most `degeneracy` candidates after it. Vertex ids
+        // follow that order, so the lowest candidate bit is always the next vertex to branch on.
+        CoreDecomposition cores = ComputeCoreDecomposition(BuildCsrGraph(neighbours));
+        ReplaceGraph(RelabelNeighbourSets(neighbours, cores.order), cores.order);
+        DispatchBitset(neighbours.size(), [&](auto empty) {
+            RunBitsetBnB(empty, cores.degeneracy + 1, best_clique.size(), cores.degeneracy + 1);
+        });
+    }
+
+    // Is there a clique with at least k vertices? The search prunes against k from the first node
+    // and stops on the first k-clique. The graph of the solver is left as it is, so the calls can
+    // be repeated with any k; a witness also improves the best clique.
+    CliqueDecision DecideClique(int k)
+    {
+        CliqueDecision decision;
+        decision.k = k;
+        if (k <= 0)
+        {
+            decision.found = true;
+            decision.bound = "trivial";
+            return decision;
+        }
+
+        BnBSolver search = *this;
+        search.best_clique.clear();
+        search.ReduceGraph(k - 1);
+        CoreDecomposition cores = ComputeCoreDecomposition(BuildCsrGraph(search.neighbours));
+        if (search.neighbours.empty())
+        {
+            decision.bound = "empty (k-1)-core";
+            return decision;
+        }
+        if (k > cores.degeneracy + 1)
+        {
+            decision.bound = "degeneracy + 1 < k";
+            return decision;
+        }
+
+        search.ReplaceGraph(RelabelNeighbourSets(search.neighbours, cores.order), cores.order);
+        DispatchBitset(search.neighbours.size(), [&](auto empty) {
+            decision.found = search.RunBitsetBnB(empty, cores.degeneracy + 1, k - 1, k);
+        });
+        decision.nodes = search.nodes;
+        if (!decision.found)
+        {
+            decision.bound = "exhaustive search, |clique| + |candidates| < k";
+            return decision;
+        }
+        decision.bound = "witness";
+        decision.witness.assign(search.best_clique.begin(), search.best_clique.end());
+        if (search.best_clique.size() > best_clique.size())
+            best_clique = search.best_clique;
+        return decision;
+    }
+
+    // Streams every maximum clique (original ids) to sink and returns how many there are. The
+    // maximum size comes from RunBnB() on a copy; the enumeration then keeps branches that can still
+    // reach it (|clique| + |candidates| < maximum prunes, equality does not) on the (maximum - 1)-core,
+    // where each clique is found exactly once as an increasing vertex sequence.
+    long long EnumerateMaximumCliques(const function<void(const vector<int>&)>& sink)
+    {
+        BnBSolver optimum = *this;
+        optimum.RunBnB();
+        best_clique = optimum.best_clique;
+        int maximum = best_clique.size();
+        if (maximum == 0)
+            return 0;
+
+        BnBSolver search = *this;
+        search.ReduceGraph(maximum - 1);
+        CoreDecomposition cores = ComputeCoreDecomposition(BuildCsrGraph(search.neighbours));
+        search.ReplaceGraph(RelabelNeighbourSets(search.neighbours, cores.order), cores.order);
+        long long count = 0;
+        vector<int> found;
+        DispatchBitset(search.neighbours.size(), [&](auto empty) {
+            search.SearchBitsetCliques(empty, cores.degeneracy + 1, maximum, cores.degeneracy + 2, false, [&](const int* clique_vertices, int size) {
+                found.clear();
+                for (int d = 0; d < size; ++d)
+                    found.push_back(search.original_ids[clique_vertices[d]]);
+                sink(found);
+                ++count;
+                return false;
+            });
+        });
+        nodes = optimum.nodes + search.nodes;
+        return count;
+    }
+
+    // The k largest maximal cliques, sent to sink from the largest down once the search is over.
+    // Only k cliques are kept; while k are known, branches that cannot beat the smallest are cut.
+    int EnumerateTopCliques(int k, const function<void(const vector<int>&)>& sink)
+    {
+        if (k <= 0)
+            return 0;
+        BnBSolver search = *this;
+        CoreDecomposition cores = ComputeCoreDecomposition(BuildCsrGraph(search.neighbours));
+        search.ReplaceGraph(RelabelNeighbourSets(search.neighbours, cores.order), cores.order);
+        auto larger = [](const vector<int>& a, const vector<int>& b) { return a.size() > b.size(); };
+        priority_queue<vector<int>, vector<vector<int>>, decltype(larger)> top(larger);
+        int need = 1;
+        DispatchBitset(search.neighbours.size(), [&](auto empty) {
+            search.SearchBitsetCliques(empty, cores.degeneracy + 1, need, cores.degeneracy + 2, true, [&](const int* clique_vertices, int size) {
+                vector<int> found(size);
+                for (int d = 0; d < size; ++d)
+                    found[d] = search.original_ids[clique_vertices[d]];
+                top.push(move(found));
+                if (int(top.size()) > k)
+                    top.pop();
+                if (int(top.size()) == k)
+                    need = top.top().size() + 1;
+                return false;
+            });
+        });
+        nodes = search.nodes;
+
+        vector<vector<int>> result;
+        while (!top.empty())
+        {
+            result.push_back(top.top());
+            top.pop();
+        }
+        if (!result.empty() && result.back().size() > best_clique.size())
+            best_clique = unordered_set<int>(result.back().begin(), result.back().end());
+        for (auto it = result.rbegin(); it != result.rend(); ++it)
+            sink(*it);
+        return result.size();
+    }
+
+    // Every maximal clique of the whole graph (no reduction) by parallel Bron-Kerbosch, see
+    // maximal_cliques.h. sink(worker, clique) gets original ids and is called from `threads` threads
+    // at once; the largest clique seen becomes best_clique.
+    long long EnumerateMaximalCliques(int threads, const function<void(int, const vector<int>&)>& sink)
+    {
+        threads = max(1, threads);
+        vector<vector<int>> found(threads);
+        vector<vector<int>> largest(threads);
+        long long count = ForEachMaximalClique(BuildCsrGraph(neighbours), threads, [&](int worker, const vector<int>& clique_vertices) {
+            vector<int>& mapped = found[worker];
+            mapped.clear();
+            for (int v : clique_vertices)
+                mapped.push_back(original_ids[v]);
+            if (mapped.size() > largest[worker].size())
+                largest[worker] = mapped;
+            sink(worker, mapped);
+        });
+        for (const vector<int>& clique_vertices : largest)
+        {
+            if (clique_vertices.size() > best_clique.size())
+                best_clique = unordered_set<int>(clique_vertices.begin(), clique_vertices.end());
+        }
+        return count;
+    }
+
+    // Maximum weight clique. The tabu incumbent fixes the weighted reduction, ids then follow the
+    // reversed degeneracy order: the dense core is coloured first and branched on last, which cut
+    // the nodes on C125.9 by two orders of magnitude against the RunBnB() order.
+    void RunWeightedBnB()
+    {
+        RunIncumbentSearch();
+        CliqueReduction reduction = ReduceForWeightedClique(neighbours, weights, best_weight);
+        reduction_stats.vertices_after = reduction.stats.vertices_after;
+        reduction_stats.edges_after = reduction.stats.edges_after;
+        ReplaceGraph(move(reduction.neighbour_sets), reduction.original_ids);
+        CoreDecomposition cores = ComputeCoreDecomposition(BuildCsrGraph(neighbours));
+        reverse(cores.order.begin(), cores.order.end());
+        ReplaceGraph(RelabelNeighbourSets(neighbours, cores.order), cores.order);
+        DispatchBitset(neighbours.size(), [&](auto empty) {
+            RunColouringBitsetBnB(empty, cores.degeneracy + 1, weights, false);
+        });
+    }
+
+    // Maximum independent set of the current graph, its complement is a minimum vertex cover. The
+    // degree-0/1/2 rules of independent_set.h shrink the graph first, then every connected component
+    // of the kernel is a maximum clique search on its complement. The search rows are the NOT of
+    // the adjacency rows, so the complement graph is never built. Components above
+    // kIndependentSetBnBLimit vertices keep their greedy set and the answer is no longer exact.
+    void RunIndependentSet()
+    {
+        IndependentSetReduction reduction = ReduceForIndependentSet(neighbours);
+        reduction_stats.vertices_after = reduction.stats.vertices_after;
+        reduction_stats.edges_after = reduction.stats.edges_after;
+        vector<int> kernel_set;
+        independent_set_exact = true;
+        kernel_components = 0;
+        long long total_nodes = 0;
+        for (CliqueReduction& component : SplitComponents(reduction.neighbour_sets))
+        {
+            ++kernel_components;
+            BnBSolver part;
+            part.neighbours = move(component.neighbour_sets);
+            part.original_ids.resize(part.neighbours.size());
+            iota(part.original_ids.begin(), part.original_ids.end(), 0);
+            for (int v : GreedyIndependentSet(part.neighbours))
+                part.best_clique.insert(v);
+            part.best_weight = part.best_clique.size();
+            if (int(part.neighbours.size()) <= kIndependentSetBnBLimit)
+                part.RunComplementBnB();
+            else
+                independent_set_exact = false;
+            total_nodes += part.nodes;
+            for (int v : part.best_clique)
+                kernel_set.push_back(component.original_ids[v]);
+        }
+        nodes = total_nodes;
+        independent_set.clear();
+        for (int v : reduction.Lift(kernel_set))
+            independent_set.insert(original_ids[v]);
+    }
+
+    // Maximum clique by bisection over DecideClique, between the tabu incumbent and degeneracy + 1.
+    // Every negative answer is an infeasibility proof that lowers the upper bound.
+    void RunBisection()
+    {
+        RunIncumbentSearch();
+        int lower = best_clique.size();
+        int upper = ComputeCoreDecomposition(BuildCsrGraph(neighbours)).degeneracy + 1;
+        long long total_nodes = 0;
+        while (lower < upper)
+        {
+            int k = lower + (upper - lower + 1) / 2;
+            CliqueDecision decision = DecideClique(k);
+            total_nodes += decision.nodes;
+            if (decision.found)
+                lower = k;
+            else
+                upper = k - 1;
+        }
+        nodes = total_nodes;
+    }
+
+    // Drops the vertices that cannot be in a clique larger than `incumbent` and relabels the rest.
+    // best_clique stays in original ids and Check() runs against the original graph.
+    void ReduceGraph(int incumbent)
+    {
+        CliqueReduction reduction = ReduceForClique(neighbours, incumbent);
+        reduction_stats.vertices_after = reduction.stats.vertices_after;
+        reduction_stats.edges_after = reduction.stats.edges_after;
+        ReplaceGraph(move(reduction.neighbour_sets), reduction.original_ids);
+    }
+
+    // Renumbers the vertices for locality (see relabel.h), also used for the tabu incumbent search
+    void RelabelVertices(VertexRelabelling vertex_relabelling)
+    {
+        relabelling = vertex_relabelling;
+        if (relabelling == VertexRelabelling::None)
+            return;
+        vector<int> order = ComputeRelabelling(BuildCsrGraph(neighbours), relabelling);
+        ReplaceGraph(RelabelNeighbourSets(neighbours, order), order);
+    }
+
+    const ReductionStats& GetReductionStats()
+    {
+        return reduction_stats;
+    }
+
+    // Search nodes of the last RunBnB()
+    long long GetNodes()
+    {
+        return nodes;
+    }
+
+    // Orbital branching in RunBnB() and DecideClique(), on by default
+    void SetSymmetryBreaking(bool enabled)
+    {
+        symmetry_breaking = enabled;
+    }
+
+    // Vertex orbits found for the root candidate set of the last search, 0 if none was searched
+    int GetRootOrbits()
+    {
+        return root_orbits;
+    }
+
+    // Candidates dropped as orbit mates of an already searched branch
+    long long GetSymmetryPruned()
+    {
+        return symmetry_pruned;
+    }
+
+    const unordered_set<int>& GetClique()
+    {
+        return best_clique;
+    }
+
+    // Result of RunIndependentSet() in original ids
+    const unordered_set<int>& GetIndependentSet()
+    {
+        return independent_set;
+    }
+
+    // Every vertex outside the independent set, a minimum vertex cover when the set is maximum
+    vector<int> GetVertexCover()
+    {
+        vector<int> cover;
+        for (int v = 0; v < reduction_stats.vertices_before; ++v)
+        {
+            if (independent_set.count(v) == 0)
+                cover.push_back(v);
+        }
+        return cover;
+    }
+
+    // False if a kernel component was too large for the exact search
+    bool IsIndependentSetExact()
+    {
+        return independent_set_exact;
+    }
+
+    int GetKernelComponents()
+    {
+        return kernel_components;
+    }
+
+    // The vertex cover check is the same: every edge has an end outside the independent set
+    bool CheckIndependentSet()
+    {
+        const vector<unordered_set<int>>& graph = original_neighbours.empty() ? neighbours : original_neighbours;
+        for (int v : independent_set)
+        {
+            for (int u : graph[v])
+            {
+                if (independent_set.count(u))
+                {
+                    cout << "Returned set is not independent\n";
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Weight of the best clique after RunBnB(), the size for an unweighted graph
+    long long GetCliqueWeight()
+    {
+        return IsWeighted() ? best_weight : best_clique.size();
+    }
+
+    bool Check()
+    {
+        const vector<unordered_set<int>>& graph = original_neighbours.empty() ? neighbours : original_neighbours;
+        for (int i : best_clique)
+        {
+            for (int j : best_clique)
+            {
+                if (i != j && graph[i].count(j) == 0)
+                {
+                    cout << "Returned subgraph is not clique\n";
+                    return false;
+                }
+            }
+        }
+        if (IsWeighted() && CliqueWeight(vertex_weights, best_clique) != best_weight)
+        {
+            cout << "Clique weight does not match its vertices\n";
+            return false;
+        }
+        return true;
+    }
+
+    void ClearClique()
+    {
+        best_clique.clear();
+        best_weight = 0;
+        clique.clear();
+    }
+
+private:
+    void RunIncumbentSearch()
+    {
+        MaxCliqueTabuSearch st;
+        st.ReadGraphFile(file);
+        if (IsWeighted())
+            st.SetVertexWeights(vertex_weights);
+        st.RelabelVertices(relabelling);
+        st.RunSearch(1, 10);
+        best_clique = st.GetClique();
+        best_weight = st.GetCliqueWeight();
+    }
+
+    // Maximum clique of the complement with unit weights, best_clique holds the incumbent. Ids go
+    // by increasing degree, so the densest vertices of the complement are coloured first as in
+    // RunWeightedBnB().
+    void RunComplementBnB()
+    {
+        int n = neighbours.size();
+        vector<int> order(n);
+        iota(order.begin(), order.end(), 0);
+        stable_sort(order.begin(), order.end(), [&](int a, int b) { return neighbours[a].size() < neighbours[b].size(); });
+        ReplaceGraph(RelabelNeighbourSets(neighbours, order), order);
+        DispatchBitset(n, [&](auto empty) {
+            RunColouringBitsetBnB(empty, n, vector<int>(n, 1), true);
+        });
+    }
+
+    // Switches to a graph whose vertex i is vertex ids[i] of the current one
+    void ReplaceGraph(vector<unordered_set<int>> graph, const vector<int>& ids)
+    {
+        vector<int> composed(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i)
+            composed[i] = original_ids[ids[i]];
+        if (original_neighbours.empty())
+            original_neighbours = move(neighbours);
+        neighbours = move(graph);
+        original_ids = move(composed);
+        weights = SelectVertexWeights(weights, ids);
+    }
+
+    // Cliques larger than `lower` replace best_clique and raise it; the search stops as soon as a
+    // clique of stop_size vertices is found and then returns true.
+    // Only one clique of each size is wanted, so symmetric branches are cut (see symmetry.h).
+    template <class Set>
+    bool RunBitsetBnB(const Set& empty, int max_depth, int lower, int stop_size)
+    {
+        int need = lower + 1;
+        CsrGraph graph = BuildCsrGraph(neighbours);
+        SymmetryBreaking symmetry(graph, max_depth, symmetry_breaking ? kSymmetryBudget : 0);
+        bool found = SearchBitsetCliques(empty, max_depth, need, stop_size, false, [&](const int* found, int size) {
+            best_clique.clear();
+            for (int d = 0; d < size; ++d)
+                best_clique.insert(original_ids[found[d]]);
+            need = size + 1;
+            return size >= stop_size;
+        }, &symmetry);
+        root_orbits = symmetry.RootOrbits();
+        symmetry_pruned = symmetry.Pruned();
+        return found;
+    }
+
+    // Weighted counterpart of SearchBitsetCliques over the same per-depth sets. On entering a node
+    // its candidates are coloured greedily in id order; bound[d][i] is the weight of the colour
+    // classes before the one of order[d][i] plus the heaviest vertex of that class up to i, an upper
+    // bound for any clique among order[d][0..i]. Branching takes the order from the back, so the
+    // first vertex whose bound cannot lift the clique past best_weight ends the node. With
+    // complement the search runs on the complement graph, whose rows are the NOT of the adjacency.
+    template <class Set>
+    void RunColouringBitsetBnB(const Set& empty, int max_depth, const vector<int>& weight, bool complement)
+    {
+        int n = neighbours.size();
+        vector<Set> rows(n, empty);
+        vector<Set> candidates(max_depth + 1, empty);
+        Set uncoloured = empty;
+        Set colour_class = empty;
+        for (int v = 0; v < n; ++v)
+        {
+            for (int u : neighbours[v])
+                rows[v].Set(u);
+            candidates[0].Set(v);
+        }
+        if (complement)
+        {
+            for (int v = 0; v < n; ++v)
+            {
+                uncoloured = rows[v];
+                rows[v] = candidates[0];
+                rows[v].AndNot(uncoloured);
+                rows[v].Reset(v);
+            }
+        }
+        vector<vector<int>> order(max_depth + 1, vector<int>(n));
+        vector<vector<long long>> bound(max_depth + 1, vector<long long>(n));
+        vector<int> remaining(max_depth + 1, 0);
+        vector<long long> clique_weight(max_depth + 1, 0);
+        clique.assign(max_depth, -1);
+        nodes = 0;
+
+        int depth = 0;
+        bool entered = true;
+        while (depth >= 0)
+        {
+            Set& current = candidates[depth];
+            if (entered)
+            {
+                entered = false;
+                ++nodes;
+                if (clique_weight[depth] > best_weight)
+                {
+                    best_clique.clear();
+                    for (int d = 0; d < depth; ++d)
+                        best_clique.insert(original_ids[clique[d]]);
+                    best_weight = clique_weight[depth];
+                }
+                int count = 0;
+                long long coloured = 0;
+                uncoloured = current;
+                while (uncoloured.Any())
+                {
+                    long long heaviest = 0;
+                    colour_class = uncoloured;
+                    for (int v = colour_class.First(); v != -1; v = colour_class.First())
+                    {
+                        colour_class.Reset(v);
+                        colour_class.AndNot(rows[v]);
+                        uncoloured.Reset(v);
+                        heaviest = max(heaviest, (long long)weight[v]);
+                        order[depth][count] = v;
+                        bound[depth][count++] = coloured + heaviest;
+                    }
+                    coloured += heaviest;
+                }
+                remaining[depth] = count;
+            }
+
+            int& next = remaining[depth];
+            if (next == 0 || clique_weight[depth] + bound[depth][next - 1] <= best_weight)
+            {
+                --depth;
+                continue;
+            }
+            int v = order[depth][--next];
+            current.Reset(v);
+            clique[depth] = v;
+            candidates[depth + 1].AssignAnd(current, rows[v]);
+            clique_weight[depth + 1] = clique_weight[depth] + weight[v];
+            ++depth;
+            entered = true;
+        }
+    }
+
+    // Set is Bitset<N> for graphs up to N vertices and DynamicBitset above 512 (see DispatchBitset).
+    // Depth-first search over an explicit stack: candidates[d] is the candidate set at depth d and
+    // clique[0..d) holds the vertices chosen on the way down. No clique has more than max_depth
+    // (degeneracy + 1) vertices, so every per-depth set is allocated once before the search.
+    // Subtrees that cannot reach `need` vertices are cut (need may be raised by on_clique). Every
+    // leaf with at least `need` vertices, or any node at stop_size, goes to on_clique(clique, size),
+    // which returns true to stop. With maximal_only, excluded[d] holds the earlier vertices that are
+    // adjacent to the whole clique, and leaves that one of them could extend are skipped. With
+    // symmetry, the rest of a vertex's orbit leaves the candidates once its branch is done; that
+    // keeps one clique of every size, so it is only for searches that do not list all of them.
+    template <class Set, class OnClique>
+    bool SearchBitsetCliques(const Set& empty, int max_depth, const int& need, int stop_size, bool maximal_only, OnClique on_clique,
+        SymmetryBreaking* symmetry = nullptr)
+    {
+        vector<Set> rows(neighbours.size(), empty);
+        vector<Set> candidates(max_depth + 1, empty);
+        vector<Set> excluded(maximal_only ? max_depth + 1 : 0, empty);
+        for (size_t v = 0; v < neighbours.size(); ++v)
+        {
+            for (int u : neighbours[v])
+                rows[v].Set(u);
+            candidates[0].Set(v);
+        }
+        clique.assign(max_depth, -1);
+        nodes = 0;
+
+        int depth = 0;
+        bool entered = true;
+        while (depth >= 0)
+        {
+            Set& current = candidates[depth];
+            if (entered)
+            {
+                entered = false;
+                ++nodes;
+                int count = depth < stop_size ? current.Count() : 0;
+                if (count == 0)
+                {
+                    if (depth >= need && (!maximal_only || !excluded[depth].Any()) && on_clique(clique.data(), depth))
+                        return true;
+                    --depth;
+                    continue;
+                }
+                if (depth + count < need)
+                {
+                    --depth;
+                    continue;
+                }
+                if (symmetry)
+                    symmetry->Enter(depth, current);
+            }
+
+            // Branch on the candidates in id order, each branch only keeps the later neighbours
+            int v = current.First();
+            if (v == -1)
+            {
+                --depth;
+                continue;
+            }
+            current.Reset(v);
+            clique[depth] = v;
+            candidates[depth + 1].AssignAnd(current, rows[v]);
+            if (symmetry)
+                symmetry->RemoveOrbit(depth, v, current);
+            if (maximal_only)
+            {
+                excluded[depth + 1].AssignAnd(excluded[depth], rows[v]);
+                excluded[depth].Set(v);
+            }
+            ++depth;
+            entered = true;
+        }
+        return false;
+    }
+
+private:
+    vector<unordered_set<int>> neighbours;
+    vector<unordered_set<int>> original_neighbours;
+    vector<int> original_ids;
+    unordered_set<int> best_clique;
+    long long best_weight = 0;
+    // Empty for an unweighted graph; vertex_weights is in file ids, weights in current ids
+    vector<int> vertex_weights;
+    vector<int> weights;
+    vector<int> clique;
+    long long nodes = 0;
+    bool symmetry_breaking = true;
+    int root_orbits = 0;
+    long long symmetry_pruned = 0;
+    unordered_set<int> independent_set;
+    bool independent_set_exact = true;
+    int kernel_components = 0;
+    ReductionStats reduction_stats;
+    VertexRelabelling relabelling = VertexRelabelling::None;
+    string file;
+};
+
+string GetProjectFolder() {
+    string path = __FILE__;
+    size_t found = path.find_last_of("\\/");
+
+    // get current project folder
+    string folderPath = path.substr(0, found);
+    return folderPath;
+}
+
+enum class BnBMode
+{
+    Optimize,
+    Bisection,
+    Decide,
+    AllMaximum,
+    TopMaximal,
+    AllMaximal,
+    Weighted,
+    IndependentSet,
+    Symmetry
+};
+
+bool ParseBnBMode(const string& name, BnBMode& mode)
+{
+    if (name == "bnb")
+        mode = BnBMode::Optimize;
+    else if (name == "bisection")
+        mode = BnBMode::Bisection;
+    else if (name == "decide")
+        mode = BnBMode::Decide;
+    else if (name == "all")
+        mode = BnBMode::AllMaximum;
+    else if (name == "top")
+        mode = BnBMode::TopMaximal;
+    else if (name == "maximal")
+        mode = BnBMode::AllMaximal;
+    else if (name == "weighted")
+        mode = BnBMode::Weighted;
+    else if (name == "independent")
+        mode = BnBMode::IndependentSet;
+    else if (name == "symmetry")
+        mode = BnBMode::Symmetry;
+    else
+        return false;
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    VertexRelabelling relabelling = VertexRelabelling::None;
+    BnBMode mode = BnBMode::Optimize;
+    int decide_k = 0;
+    if ((argc > 1 && !ParseVertexRelabelling(argv[1], relabelling)) ||
+        (argc > 2 && !ParseBnBMode(argv[2], mode)) ||
+        ((mode == BnBMode::Decide || mode == BnBMode::TopMaximal) && (argc < 4 || (decide_k = atoi(argv[3])) <= 0)))
+    {
+        cout << "Usage: bbound [none|degree|degeneracy|rcm] [bnb|bisection|decide k|all|top k|maximal [threads]|weighted|independent|symmetry]\n";
+        return 1;
+    }
+    string projFolder = GetProjectFolder();
+    string cliqueF = projFolder + "/../cliques/";
+
+    ios_base::sync_with_stdio(false);
+    cin.tie(nullptr);
+    vector<string> files = {
+        cliqueF + "brock200_1.clq", cliqueF + "brock200_2.clq", cliqueF + "brock200_3.clq", cliqueF + "brock200_4.clq",
+        cliqueF + "C125.9.clq",
+        cliqueF + "gen200_p0.9_44.clq", cliqueF + "gen200_p0.9_55.clq",
+        cliqueF + "hamming8-4.clq",
+        cliqueF + "johnson16-2-4.clq", cliqueF + "johnson8-2-4.clq",
+        cliqueF + "keller4.clq",
+        cliqueF + "MANN_a27.clq", cliqueF + "MANN_a9.clq",
+        cliqueF + "p_hat1000-1.clq", cliqueF + "p_hat1500-1.clq", cliqueF + "p_hat300-3.clq",
+        cliqueF + "san1000.clq", cliqueF + "sanr200_0.9.clq"
+    };
+    if (mode == BnBMode::AllMaximal)
+        files.push_back(cliqueF + "DSJC1000_5.clq");
+    files = SelectInstances(files);
+    if (mode == BnBMode::Decide)
+    {
+        ofstream fout("clique_decide.csv");
+        fout << "File; k; Found; Nodes; Bound; Time (sec)\n";
+        for (string file : files)
+        {
+            BnBSolver problem;
+            problem.ReadGraphFile(file);
+            problem.ClearClique();
+            clock_t start = clock();
+            problem.RelabelVertices(relabelling);
+            CliqueDecision decision = problem.DecideClique(decide_k);
+            if (decision.found && !problem.Check())
+            {
+                cout << "*** WARNING: incorrect clique ***\n";
+                fout << "*** WARNING: incorrect clique ***\n";
+            }
+            double time = double(clock() - start) / CLOCKS_PER_SEC;
+            fout << file << "; " << decision.k << "; " << (decision.found ? "yes" : "no") << "; " << decision.nodes << "; "
+                << decision.bound << "; " << time << '\n';
+            cout << file << ", clique of " << decision.k << " - " << (decision.found ? "yes" : "no, " + decision.bound)
+                << ", nodes - " << decision.nodes << ", time - " << time << '\n';
+        }
+        return 0;
+    }
+    if (mode == BnBMode::IndependentSet)
+    {
+        // Sparse colouring instances, where the reductions do most of the work
+        string graphF = projFolder + "/../../vertexcolor/graphs/";
+        vector<string> sparse_files = SelectInstances({
+            graphF + "anna.col", graphF + "david.col", graphF + "homer.col", graphF + "huck.col", graphF + "jean.col",
+            graphF + "fpsol2.i.1.col", graphF + "inithx.i.1.col", graphF + "mulsol.i.1.col", graphF + "zeroin.i.1.col",
+            graphF + "games120.col", graphF + "miles250.col", graphF + "miles1000.col",
+            graphF + "le450_25a.col", graphF + "myciel7.col", graphF + "queen8_8.col", graphF + "school1.col"
+        });
+        ofstream fout("independent_set.csv");
+        fout << "File; Independent set; Vertex cover; Exact; Vertices; Kernel vertices; Edges; Kernel edges; Components; Nodes; Time (sec)\n";
+        for (string file : sparse_files)
+        {
+            BnBSolver problem;
+            problem.ReadGraphFile(file);
+            clock_t start = clock();
+            problem.RelabelVertices(relabelling);
+            problem.RunIndependentSet();
+            if (!problem.CheckIndependentSet())
+            {
+                cout << "*** WARNING: incorrect independent set ***\n";
+                fout << "*** WARNING: incorrect independent set ***\n";
+            }
+            double time = double(clock() - start) / CLOCKS_PER_SEC;
+            ReportResult("independent_set", file, problem.GetIndependentSet().size());
+            const ReductionStats& reduction = problem.GetReductionStats();
+            fout << file << "; " << problem.GetIndependentSet().size() << "; " << problem.GetVertexCover().size() << "; "
+                << (problem.IsIndependentSetExact() ? "yes" : "no") << "; " << reduction.vertices_before << "; " << reduction.vertices_after << "; "
+                << reduction.edges_before << "; " << reduction.edges_after << "; " << problem.GetKernelComponents() << "; " << problem.GetNodes() << "; " << time << '\n';
+            cout << file << ", independent set - " << problem.GetIndependentSet().size() << ", vertex cover - " << problem.GetVertexCover().size()
+                << (problem.IsIndependentSetExact() ? "" : " (not proven)") << ", kernel " << reduction.vertices_after << "/" << reduction.vertices_before
+                << " vertices, time - " << time << '\n';
+        }
+        return 0;
+    }
+    if (mode == BnBMode::Symmetry)
+    {
+        // Vertex-transitive or nearly so, with and without orbital branching. Without it johnson32-2-4
+        // takes far too long, it only runs with it.
+        vector<string> symmetric_files = SelectInstances({
+            cliqueF + "hamming6-2.clq", cliqueF + "hamming6-4.clq", cliqueF + "hamming8-4.clq",
+            cliqueF + "johnson8-2-4.clq", cliqueF + "johnson8-4-4.clq", cliqueF + "johnson16-2-4.clq",
+            cliqueF + "keller4.clq", cliqueF + "MANN_a9.clq", cliqueF + "johnson32-2-4.clq"
+        });
+        ofstream fout("clique_symmetry.csv");
+        fout << "File; Symmetry breaking; Clique; Root orbits; Pruned candidates; Nodes; Time (sec)\n";
+        for (size_t i = 0; i < symmetric_files.size(); ++i)
+        {
+            bool compared = symmetric_files[i].find("johnson32-2-4") == string::npos;
+            for (int breaking = compared ? 0 : 1; breaking < 2; ++breaking)
+            {
+                BnBSolver problem;
+                problem.ReadGraphFile(symmetric_files[i]);
+                problem.ClearClique();
+                problem.SetSymmetryBreaking(breaking);
+                clock_t start = clock();
+                problem.RelabelVertices(relabelling);
+                problem.RunBnB();
+                if (!problem.Check())
+                {
+                    cout << "*** WARNING: incorrect clique ***\n";
+                    fout << "*** WARNING: incorrect clique ***\n";
+                }
+                double time = double(clock() - start) / CLOCKS_PER_SEC;
+                fout << symmetric_files[i] << "; " << (breaking ? "yes" : "no") << "; " << problem.GetClique().size() << "; " << problem.GetRootOrbits() << "; "
+                    << problem.GetSymmetryPruned() << "; " << problem.GetNodes() << "; " << time << '\n';
+                cout << symmetric_files[i] << (breaking ? ", orbital branching" : ", plain") << ", result - " << problem.GetClique().size()
+                    << ", root orbits - " << problem.GetRootOrbits() << ", nodes - " << problem.GetNodes() << ", time - " << time << '\n';
+            }
+        }
+        return 0;
+    }
+    if (mode == BnBMode::AllMaximal)
+    {
+        // Only counts are written, clique output on DSJC1000_5 would run to gigabytes. Wall time, the
+        // enumeration runs on several threads.
+        int threads = argc > 3 ? max(1, atoi(argv[3])) : max(1u, thread::hardware_concurrency());
+        ofstream fout("clique_maximal.csv");
+        fout << "File; Threads; Maximal cliques; Largest; Time (sec); Cliques per sec\n";
+        for (string file : files)
+        {
+            BnBSolver problem;
+            problem.ReadGraphFile(file);
+            problem.ClearClique();
+            auto start = chrono::steady_clock::now();
+            problem.RelabelVertices(relabelling);
+            long long count = problem.EnumerateMaximalCliques(threads, [](int, const vector<int>&) {});
+            if (!problem.Check())
+            {
+                cout << "*** WARNING: incorrect clique ***\n";
+                fout << "*** WARNING: incorrect clique ***\n";
+            }
+            double time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            fout << file << "; " << threads << "; " << count << "; " << problem.GetClique().size() << "; " << time << "; "
+                << count / max(time, 1e-9) << '\n';
+            cout << file << ", maximal cliques - " << count << ", largest - " << problem.GetClique().size() << ", time - " << time << '\n';
+        }
+        return 0;
+    }
+    if (mode == BnBMode::AllMaximum || mode == BnBMode::TopMaximal)
+    {
+        // Cliques go to a text file as they arrive, one line of 1-based vertex ids each
+        bool all = mode == BnBMode::AllMaximum;
+        ofstream fout(all ? "clique_all.csv" : "clique_top.csv");
+        ofstream cliques_out(all ? "clique_all.txt" : "clique_top.txt");
+        fout << "File; Clique; Cliques; Nodes; Time (sec)\n";
+        for (string file : files)
+        {
+            BnBSolver problem;
+            problem.ReadGraphFile(file);
+            problem.ClearClique();
+            clock_t start = clock();
+            problem.RelabelVertices(relabelling);
+            cliques_out << "c " << file << '\n';
+            auto sink = [&](const vector<int>& found) {
+                for (size_t i = 0; i < found.size(); ++i)
+                    cliques_out << (i ? " " : "") << found[i] + 1;
+                cliques_out << '\n';
+            };
+            long long count = all ? problem.EnumerateMaximumCliques(sink) : problem.EnumerateTopCliques(decide_k, sink);
+            if (!problem.Check())
+            {
+                cout << "*** WARNING: incorrect clique ***\n";
+                fout << "*** WARNING: incorrect clique ***\n";
+            }
+            double time = double(clock() - start) / CLOCKS_PER_SEC;
+            fout << file << "; " << problem.GetClique().size() << "; " << count << "; " << problem.GetNodes() << "; " << time << '\n';
+            cout << file << ", result - " << problem.GetClique().size() << ", " << (all ? "maximum" : "top maximal") << " cliques - " << count
+                << ", nodes - " << problem.GetNodes() << ", time - " << time << '\n';
+        }
+        return 0;
+    }
+
+    ofstream fout(mode == BnBMode::Bisection ? "clique_bisection.csv" : mode == BnBMode::Weighted ? "clique_weighted.csv" : "clique_bnb.csv");
+    fout << "File; Clique; Weight; Time (sec); Vertices; Reduced vertices; Edges; Reduced edges; Nodes; Nodes per sec\n";
+    for (string file : files)
+    {
+        BnBSolver problem;
+        problem.ReadGraphFile(file, mode == BnBMode::Weighted);
+        problem.ClearClique();
+        clock_t start = clock();
+        problem.RelabelVertices(relabelling);
+        if (mode == BnBMode::Bisection)
+            problem.RunBisection();
+        else
+            problem.RunBnB();
+        if (!problem.Check())
+        {
+            cout << "*** WARNING: incorrect clique ***\n";
+            fout << "*** WARNING: incorrect clique ***\n";
+        }
+        double time = double(clock() - start) / CLOCKS_PER_SEC;
+        bool weighted = mode == BnBMode::Weighted;
+        ReportResult(weighted ? "weighted_clique" : "clique", file, weighted ? problem.GetCliqueWeight() : problem.GetClique().size());
+        const ReductionStats& reduction = problem.GetReductionStats();
+        fout << file << "; " << problem.GetClique().size() << "; " << problem.GetCliqueWeight() << "; " << time << "; "
+            << reduction.vertices_before << "; " << reduction.vertices_after << "; " << reduction.edges_before << "; " << reduction.edges_after << "; "
+            << problem.GetNodes() << "; " << problem.GetNodes() / max(time, 1e-9) << '\n';
+        cout << file << ", result - " << problem.GetClique().size() << ", weight - " << problem.GetCliqueWeight() << ", time - " << time
+            << ", reduced to " << reduction.vertices_after << "/" << reduction.vertices_before << " vertices, nodes - " << problem.GetNodes() << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+# Profile-guided optimisation of the four solvers, run by the `pgo` target of the root project:
+#   1. a plain Release (-O3) build of the solvers as the baseline
+#   2. an instrumented build, trained on a subset of cliques/ and graphs/ with a time cap per run
+#   3. the profiles merged: llvm-profdata for Clang, GCC adds to its .gcda counters on every exit
+#   4. the instrumented build directory rebuilt with the profiles, so the object paths match them
+#   5. baseline and PGO binaries timed on instances left out of the training, the speedup per
+#      solver is printed and written to pgo_report.csv
+# Expects SOURCE_DIR, WORK_DIR, GENERATOR, CXX_COMPILER, COMPILER_ID and, for Clang, PROFDATA.
+cmake_minimum_required(VERSION 3.23)
+
+set(SOLVERS vertexcolor bbound locsearch maxclique)
+# A training run killed at the cap leaves no profile, the caps only guard against a stuck run
+set(TRAINING_TIMEOUT 120)
+set(EVALUATION_TIMEOUT 300)
+# Every timed run is repeated, the fastest counts
+set(REPETITIONS 3)
+
+set(BASELINE_DIR ${WORK_DIR}/baseline)
+set(PGO_DIR ${WORK_DIR}/optimized)
+set(PROFILE_DIR ${WORK_DIR}/profiles)
+set(RUN_DIR ${WORK_DIR}/run)
+
+set(CLIQUES ${SOURCE_DIR}/bbound/cliques)
+set(GRAPHS ${SOURCE_DIR}/vertexcolor/graphs)
+
+if (COMPILER_ID STREQUAL "GNU")
+    set(GENERATE_FLAGS "-fprofile-generate=${PROFILE_DIR} -fprofile-update=prefer-atomic")
+    set(USE_FLAGS "-fprofile-use=${PROFILE_DIR} -fprofile-partial-training -Wno-missing-profile")
+elseif (COMPILER_ID MATCHES "Clang")
+    if (NOT PROFDATA)
+        message(FATAL_ERROR "PGO with Clang needs llvm-profdata")
+    endif()
+    set(GENERATE_FLAGS "-fprofile-instr-generate=${PROFILE_DIR}/%p.profraw")
+    set(USE_FLAGS "-fprofile-instr-use=${PROFILE_DIR}/merged.profdata -Wno-profile-instr-unprofiled")
+else()
+    message(FATAL_ERROR "PGO is set up for GCC and Clang, not ${COMPILER_ID}")
+endif()
+
+function(build_solvers dir flags)
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} -S ${SOURCE_DIR} -B ${dir} -G ${GENERATOR} -DCMAKE_BUILD_TYPE=Release
+            -DCMAKE_CXX_COMPILER=${CXX_COMPILER} -DCMAKE_CXX_FLAGS=${flags}
+        OUTPUT_QUIET
+        COMMAND_ERROR_IS_FATAL ANY)
+    execute_process(COMMAND ${CMAKE_COMMAND} --build ${dir} --target ${SOLVERS} COMMAND_ERROR_IS_FATAL ANY)
+endfunction()
+
+# Wall time of one solver run in microseconds, -1 if it failed or hit the timeout. instances is a
+# list of files, handed over in MODERNOP_INSTANCES.
+function(run_solver dir solver arguments instances timeout result)
+    set(ENV{MODERNOP_INSTANCES} "${instances}")
+    separate_arguments(argv UNIX_COMMAND "${arguments}")
+    string(TIMESTAMP start "%s%f" UTC)
+    execute_process(
+        COMMAND ${dir}/${solver}/${solver} ${argv}
+        WORKING_DIRECTORY ${RUN_DIR}
+        OUTPUT_QUIET
+        ERROR_QUIET
+        TIMEOUT ${timeout}
+        RESULT_VARIABLE code)
+    string(TIMESTAMP end "%s%f" UTC)
+    if (NOT code EQUAL 0)
+        message(WARNING "${solver} ${arguments} on ${instances}: ${code}")
+        set(${result} -1 PARENT_SCOPE)
+        return()
+    endif()
+    math(EXPR elapsed "${end} - ${start}")
+    set(${result} ${elapsed} PARENT_SCOPE)
+endfunction()
+
+file(REMOVE_RECURSE ${PROFILE_DIR} ${RUN_DIR})
+file(MAKE_DIRECTORY ${PROFILE_DIR} ${RUN_DIR})
+
+message(STATUS "PGO: baseline build in ${BASELINE_DIR}")
+build_solvers(${BASELINE_DIR} "")
+message(STATUS "PGO: instrumented build in ${PGO_DIR}")
+build_solvers(${PGO_DIR} "${GENERATE_FLAGS}")
+
+# Training: the main modes of every solver on small and medium instances of each family
+message(STATUS "PGO: training")
+set(training_cliques ${CLIQUES}/brock200_4.clq ${CLIQUES}/keller4.clq ${CLIQUES}/MANN_a9.clq
+    ${CLIQUES}/hamming8-4.clq ${CLIQUES}/p_hat500-1.clq)
+set(training_graphs ${GRAPHS}/myciel7.col ${GRAPHS}/le450_15b.col ${GRAPHS}/queen11_11.col ${GRAPHS}/school1.col)
+foreach (arguments "dsatur none" "rlf none" "welshpowell iteratedgreedy" "greedy tabucol" "jp none")
+    run_solver(${PGO_DIR} vertexcolor "${arguments}" "${training_graphs}" ${TRAINING_TIMEOUT} time)
+endforeach()
+foreach (arguments "none bnb" "degeneracy weighted" "none decide 10")
+    run_solver(${PGO_DIR} bbound "${arguments}" "${training_cliques}" ${TRAINING_TIMEOUT} time)
+endforeach()
+run_solver(${PGO_DIR} bbound "none independent" "${GRAPHS}/queen8_8.col;${GRAPHS}/miles250.col" ${TRAINING_TIMEOUT} time)
+foreach (solver locsearch maxclique)
+    run_solver(${PGO_DIR} ${solver} "none" "${training_cliques}" ${TRAINING_TIMEOUT} time)
+    run_solver(${PGO_DIR} ${solver} "none weighted" "${CLIQUES}/brock200_4.clq;${CLIQUES}/C125.9.clq" ${TRAINING_TIMEOUT} time)
+endforeach()
+
+if (COMPILER_ID MATCHES "Clang")
+    file(GLOB raw_profiles ${PROFILE_DIR}/*.profraw)
+    execute_process(COMMAND ${PROFDATA} merge -o ${PROFILE_DIR}/merged.profdata ${raw_profiles} COMMAND_ERROR_IS_FATAL ANY)
+endif()
+
+message(STATUS "PGO: optimized build in ${PGO_DIR}")
+build_solvers(${PGO_DIR} "${USE_FLAGS}")
+
+# Evaluation on instances the training did not see
+message(STATUS "PGO: timing -O3 against PGO, best of ${REPETITIONS}")
+set(evaluation_vertexcolor "greedy tabucol|${GRAPHS}/le450_5a.col;${GRAPHS}/queen12_12.col")
+set(evaluation_bbound "none bnb|${CLIQUES}/p_hat300-2.clq;${CLIQUES}/sanr200_0.7.clq;${CLIQUES}/brock200_2.clq")
+set(evaluation_locsearch "none|${CLIQUES}/p_hat300-3.clq;${CLIQUES}/san400_0.7_1.clq")
+set(evaluation_maxclique "none|${CLIQUES}/brock400_2.clq;${CLIQUES}/sanr400_0.7.clq;${CLIQUES}/p_hat1000-1.clq")
+
+set(report "Solver; Arguments; -O3 (ms); PGO (ms); Speedup\n")
+foreach (solver ${SOLVERS})
+    string(FIND "${evaluation_${solver}}" "|" split)
+    string(SUBSTRING "${evaluation_${solver}}" 0 ${split} arguments)
+    math(EXPR split "${split} + 1")
+    string(SUBSTRING "${evaluation_${solver}}" ${split} -1 instances)
+    foreach (build baseline optimized)
+        set(best_${build} -1)
+        if (build STREQUAL "baseline")
+            set(dir ${BASELINE_DIR})
+        else()
+            set(dir ${PGO_DIR})
+        endif()
+        foreach (repetition RANGE 1 ${REPETITIONS})
+            run_solver(${dir} ${solver} "${arguments}" "${instances}" ${EVALUATION_TIMEOUT} time)
+            if (time GREATER_EQUAL 0 AND (best_${build} LESS 0 OR time LESS best_${build}))
+                set(best_${build} ${time})
+            endif()
+        endforeach()
+    endforeach()
+    if (best_baseline LESS 0 OR best_optimized LESS_EQUAL 0)
+        set(line "${solver}; ${arguments}; failed; failed; -")
+    else()
+        # Fixed point, CMake arithmetic is integer only
+        math(EXPR speedup "${best_baseline} * 1000 / ${best_optimized}")
+        math(EXPR speedup_int "${speedup} / 1000")
+        math(EXPR speedup_frac "${speedup} % 1000 + 1000")
+        string(SUBSTRING ${speedup_frac} 1 3 speedup_frac)
+        math(EXPR baseline_ms "${best_baseline} / 1000")
+        math(EXPR optimized_ms "${best_optimized} / 1000")
+        set(line "${solver}; ${arguments}; ${baseline_ms}; ${optimized_ms}; ${speedup_int}.${speedup_frac}")
+    endif()
+    message(STATUS "PGO: ${line}")
+    string(APPEND report "${line}\n")
+endforeach()
+file(WRITE ${WORK_DIR}/pgo_report.csv "${report}")
+message(STATUS "PGO: report in ${WORK_DIR}/pgo_report.csv, binaries in ${PGO_DIR}")
@@ -0,0 +1,487 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <unordered_set>
+#include <cstdlib>
+#include "csr_graph.h"
+#include "dimacs.h"
+#include "instances.h"
+#include "first_fit.h"
+#include "simd_kernels.h"
+using namespace std;
+
+// Microbenchmarks for the hot graph kernels of the solvers, each kernel on every adjacency backend:
+// unordered_set (the solvers' neighbour_sets), sorted CSR rows, and bitset rows through each
+// BitKernels variant the CPU supports. Inputs are G(n, p) graphs from fixed seeds over a size and
+// density sweep plus bundled DIMACS instances. One repetition runs a case often enough to take
+// kMinRepetitionSeconds; the median, min and max ns per operation over the repetitions and the
+// items per second at the median are reported. The backends of a kernel must agree on a checksum.
+
+constexpr double kMinRepetitionSeconds = 0.02;
+
+volatile long long sink = 0;
+
+struct Timing
+{
+    double median;
+    double min;
+    double max;
+};
+
+// Seconds per call of `batch`, the call count of a repetition calibrated once beforehand
+Timing TimeBatch(const function<long long()>& batch, int repetitions)
+{
+    auto run = [&](long long calls) {
+        auto start = chrono::steady_clock::now();
+        for (long long i = 0; i < calls; ++i)
+            sink += batch();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    long long calls = 1;
+    for (double elapsed = run(calls); elapsed < kMinRepetitionSeconds; elapsed = run(calls))
+        calls = elapsed > 0 ? max(calls * 2, (long long)(calls * 1.2 * kMinRepetitionSeconds / elapsed)) : calls * 2;
+
+    vector<double> samples;
+    for (int r = 0; r < repetitions; ++r)
+        samples.push_back(run(calls) / calls);
+    sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    double median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    return { median, samples.front(), samples.back() };
+}
+
+// One input in every representation. rows and non_rows are n rows of `words` words: the
+// adjacency and its complement without the diagonal.
+struct BenchGraph
+{
+    string name;
+    string file;
+    vector<unordered_set<int>> neighbour_sets;
+    vector<unordered_set<int>> non_neighbours;
+    CsrGraph csr;
+    int words = 0;
+    vector<uint64_t> rows;
+    vector<uint64_t> non_rows;
+
+    int Size() const { return neighbour_sets.size(); }
+    const uint64_t* Row(int v) const { return rows.data() + size_t(v) * words; }
+    const uint64_t* NonRow(int v) const { return non_rows.data() + size_t(v) * words; }
+    double Density() const { return Size() > 1 ? double(csr.targets.size()) / (double(Size()) * (Size() - 1)) : 0; }
+};
+
+vector<uint64_t> BuildBitRows(const CsrGraph& graph, int words)
+{
+    vector<uint64_t> rows(size_t(graph.Size()) * words, 0);
+    for (int v = 0; v < graph.Size(); ++v)
+    {
+        for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+            rows[size_t(v) * words + (graph.targets[e] >> 6)] |= uint64_t(1) << (graph.targets[e] & 63);
+    }
+    return rows;
+}
+
+BenchGraph MakeBenchGraph(string name, string file, vector<unordered_set<int>> neighbour_sets)
+{
+    BenchGraph graph;
+    graph.name = name;
+    graph.file = file;
+    graph.neighbour_sets = move(neighbour_sets);
+    int n = graph.Size();
+    graph.csr = BuildCsrGraph(graph.neighbour_sets);
+    graph.words = (n + 63) / 64;
+    graph.rows = BuildBitRows(graph.csr, graph.words);
+    graph.non_rows.assign(graph.rows.size(), 0);
+    graph.non_neighbours.assign(n, unordered_set<int>());
+    for (int v = 0; v < n; ++v)
+    {
+        for (int u = 0; u < n; ++u)
+        {
+            if (u != v && !graph.neighbour_sets[v].count(u))
+            {
+                graph.non_neighbours[v].insert(u);
+                graph.non_rows[size_t(v) * graph.words + (u >> 6)] |= uint64_t(1) << (u & 63);
+            }
+        }
+    }
+    return graph;
+}
+
+// G(n, p) from a seed of its own, so every run and every machine benchmarks the same graph
+BenchGraph RandomGraph(int n, double p)
+{
+    mt19937_64 generator(n * 1000 + int(p * 100));
+    bernoulli_distribution edge(p);
+    vector<unordered_set<int>> neighbour_sets(n);
+    for (int u = 0; u < n; ++u)
+    {
+        for (int v = u + 1; v < n; ++v)
+        {
+            if (edge(generator))
+            {
+                neighbour_sets[u].insert(v);
+                neighbour_sets[v].insert(u);
+            }
+        }
+    }
+    return MakeBenchGraph("G(" + to_string(n) + ", " + to_string(p).substr(0, 3) + ")", "", move(neighbour_sets));
+}
+
+struct BenchCase
+{
+    string backend;
+    function<long long()> batch;
+};
+
+class GraphBench
+{
+public:
+    GraphBench(int repetitions, string only) : repetitions(repetitions), only(only)
+    {
+        variants = { &GetScalarKernels() };
+        if (CpuSupportsAvx2())
+            variants.push_back(&GetAvx2Kernels());
+        if (CpuSupportsAvx512())
+            variants.push_back(&GetAvx512Kernels());
+    }
+
+    void Run(const BenchGraph& graph)
+    {
+        int n = graph.Size();
+        if (n == 0)
+            return;
+        mt19937_64 generator(12345);
+
+        // A maximal clique grown in random order, the set the local search keeps tightness against
+        vector<int> order(n);
+        for (int v = 0; v < n; ++v)
+            order[v] = v;
+        shuffle(order.begin(), order.end(), generator);
+        vector<int> clique;
+        for (int v : order)
+        {
+            if (all_of(clique.begin(), clique.end(), [&](int u) { return graph.neighbour_sets[v].count(u) > 0; }))
+                clique.push_back(v);
+        }
+        vector<uint64_t> clique_bits = ToBits(clique, graph.words);
+
+        // Candidate set of a branch and bound node: every vertex with probability 1/2
+        vector<int> candidates;
+        for (int v = 0; v < n; ++v)
+        {
+            if (generator() & 1)
+                candidates.push_back(v);
+        }
+        unordered_set<int> candidate_set(candidates.begin(), candidates.end());
+        vector<uint64_t> candidate_bits = ToBits(candidates, graph.words);
+
+        int max_degree = 0;
+        for (int v = 0; v < n; ++v)
+            max_degree = max(max_degree, graph.csr.Degree(v));
+        long long adjacency = graph.csr.targets.size();
+        long long q = clique.size();
+        long long p = candidates.size();
+
+        if (!graph.file.empty())
+        {
+            auto read = [&](int representation) {
+                DimacsGraph loaded = ReadDimacsGraph(graph.file);
+                if (representation == 0)
+                    return (long long)loaded.neighbour_sets.size();
+                CsrGraph csr = BuildCsrGraph(loaded.neighbour_sets);
+                if (representation == 1)
+                    return (long long)csr.targets.size();
+                return (long long)BuildBitRows(csr, (csr.Size() + 63) / 64).size();
+            };
+            // Parsing is the same for all three, the cost of building each representation is on top
+            Report("dimacs_read", graph, 1, adjacency / 2, {
+                { "unordered_set", [&] { return read(0); } },
+                { "csr", [&] { return read(1); } },
+                { "bitset", [&] { return read(2); } },
+            }, false);
+        }
+
+        // ComputeTightness of every vertex: clique members it is not adjacent to
+        vector<BenchCase> tightness = {
+            { "unordered_set", [&] {
+                long long sum = 0;
+                for (int v = 0; v < n; ++v)
+                {
+                    for (int u : clique)
+                        sum += graph.non_neighbours[u].count(v);
+                }
+                return sum;
+            } },
+            { "csr", [&] {
+                long long sum = 0;
+                for (int v = 0; v < n; ++v)
+                {
+                    for (int u : clique)
+                    {
+                        const int* row = graph.csr.targets.data() + graph.csr.offsets[u];
+                        sum += u != v && !binary_search(row, row + graph.csr.Degree(u), v);
+                    }
+                }
+                return sum;
+            } },
+        };
+        for (const BitKernels* k : variants)
+        {
+            tightness.push_back({ string("bitset-") + k->name, [&, k] {
+                long long sum = 0;
+                for (int v = 0; v < n; ++v)
+                    sum += k->intersection_count(clique_bits.data(), graph.NonRow(v), graph.words);
+                return sum;
+            } });
+        }
+        Report("tightness", graph, n, n * q, tightness);
+
+        // Candidate filtering: the next candidate set P & N(v) of a branch, built and counted
+        vector<int> filtered;
+        filtered.reserve(n);
+        vector<uint64_t> next(graph.words);
+        vector<BenchCase> filter = {
+            { "unordered_set", [&] {
+                long long sum = 0;
+                for (int v = 0; v < n; ++v)
+                {
+                    filtered.clear();
+                    for (int u : candidate_set)
+                    {
+                        if (graph.neighbour_sets[v].count(u))
+                            filtered.push_back(u);
+                    }
+                    sum += filtered.size();
+                }
+                return sum;
+            } },
+            { "csr", [&] {
+                long long sum = 0;
+                for (int v = 0; v < n; ++v)
+                {
+                    filtered.clear();
+                    const int* row = graph.csr.targets.data() + graph.csr.offsets[v];
+                    set_intersection(candidates.begin(), candidates.end(), row, row + graph.csr.Degree(v), back_inserter(filtered));
+                    sum += filtered.size();
+                }
+                return sum;
+            } },
+        };
+        for (const BitKernels* k : variants)
+        {
+            filter.push_back({ string("bitset-") + k->name, [&, k] {
+                long long sum = 0;
+                for (int v = 0; v < n; ++v)
+                {
+                    k->and_rows(next.data(), candidate_bits.data(), graph.Row(v), graph.words);
+                    sum += k->popcount_row(next.data(), graph.words);
+                }
+                return sum;
+            } });
+        }
+        Report("candidate_filter", graph, n, n * p, filter);
+
+        // First-fit colouring of all vertices in id order, the Welsh-Powell inner loop. Checksum:
+        // the number of colours, the same for every backend.
+        vector<int> colors(n);
+        vector<uint64_t> classes;
+        vector<BenchCase> first_fit = {
+            { "unordered_set", [&] {
+                fill(colors.begin(), colors.end(), 0);
+                int used = 0;
+                for (int v = 0; v < n; ++v)
+                {
+                    unordered_set<int> neighbour_colors;
+                    for (int u : graph.neighbour_sets[v])
+                    {
+                        if (colors[u])
+                            neighbour_colors.insert(colors[u]);
+                    }
+                    int color = 1;
+                    while (neighbour_colors.count(color))
+                        ++color;
+                    colors[v] = color;
+                    used = max(used, color);
+                }
+                return (long long)used;
+            } },
+            { "csr", [&] {
+                fill(colors.begin(), colors.end(), 0);
+                FirstFitKernel kernel(max_degree);
+                int used = 0;
+                for (int v = 0; v < n; ++v)
+                {
+                    colors[v] = kernel.Choose(graph.csr.targets.data() + graph.csr.offsets[v], graph.csr.Degree(v), colors.data());
+                    used = max(used, colors[v]);
+                }
+                return (long long)used;
+            } },
+        };
+        for (const BitKernels* k : variants)
+        {
+            // Colour classes as bit rows: the first class v has no neighbour in
+            first_fit.push_back({ string("bitset-") + k->name, [&, k] {
+                classes.assign(size_t(max_degree + 1) * graph.words, 0);
+                int used = 0;
+                for (int v = 0; v < n; ++v)
+                {
+                    int color = 0;
+                    while (color < used && k->intersection_count(classes.data() + size_t(color) * graph.words, graph.Row(v), graph.words))
+                        ++color;
+                    classes[size_t(color) * graph.words + (v >> 6)] |= uint64_t(1) << (v & 63);
+                    used = max(used, color + 1);
+                }
+                return (long long)used;
+            } });
+        }
+        Report("first_fit", graph, n, adjacency, first_fit);
+        // The colouring for the checks, also when first_fit itself was not selected
+        first_fit[1].batch();
+        first_fit.back().batch();
+
+        // Check of the first-fit colouring left in colors and classes: conflicting (vertex, neighbour) pairs
+        vector<BenchCase> check = {
+            { "unordered_set", [&] {
+                long long conflicts = 0;
+                for (int v = 0; v < n; ++v)
+                {
+                    for (int u : graph.neighbour_sets[v])
+                        conflicts += colors[u] == colors[v];
+                }
+                return conflicts;
+            } },
+            { "csr", [&] {
+                long long conflicts = 0;
+                for (int v = 0; v < n; ++v)
+                {
+                    for (int e = graph.csr.offsets[v]; e < graph.csr.offsets[v + 1]; ++e)
+                        conflicts += colors[graph.csr.targets[e]] == colors[v];
+                }
+                return conflicts;
+            } },
+        };
+        for (const BitKernels* k : variants)
+        {
+            check.push_back({ string("bitset-") + k->name, [&, k] {
+                long long conflicts = 0;
+                for (int v = 0; v < n; ++v)
+                    conflicts += k->intersection_count(classes.data() + size_t(colors[v] - 1) * graph.words, graph.Row(v), graph.words);
+                return conflicts;
+            } });
+        }
+        Report("check_coloring", graph, n, adjacency, check);
+
+        // Check of a clique: vertex pairs of the clique that are not adjacent
+        vector<BenchCase> clique_check = {
+            { "unordered_set", [&] {
+                long long missing = 0;
+                for (int u : clique)
+                {
+                    for (int v : clique)
+                        missing += u != v && graph.neighbour_sets[u].count(v) == 0;
+                }
+                return missing;
+            } },
+            { "csr", [&] {
+                long long missing = 0;
+                for (int u : clique)
+                {
+                    const int* row = graph.csr.targets.data() + graph.csr.offsets[u];
+                    for (int v : clique)
+                        missing += u != v && !binary_search(row, row + graph.csr.Degree(u), v);
+                }
+                return missing;
+            } },
+        };
+        for (const BitKernels* k : variants)
+        {
+            clique_check.push_back({ string("bitset-") + k->name, [&, k] {
+                long long missing = 0;
+                for (int u : clique)
+                    missing += k->intersection_count(clique_bits.data(), graph.NonRow(u), graph.words);
+                return missing;
+            } });
+        }
+        Report("check_clique", graph, q, q * q, clique_check);
+    }
+
+    bool Correct() const { return correct; }
+
+private:
+    static vector<uint64_t> ToBits(const vector<int>& vertices, int words)
+    {
+        vector<uint64_t> bits(words, 0);
+        for (int v : vertices)
+            bits[v >> 6] |= uint64_t(1) << (v & 63);
+        return bits;
+    }
+
+    // ops and items are per batch: ns/op divides a batch by ops, items/sec counts items at the median
+    void Report(const string& kernel, const BenchGraph& graph, long long ops, long long items, const vector<BenchCase>& cases, bool checked = true)
+    {
+        if (!only.empty() && only != kernel)
+            return;
+        ops = max(1LL, ops);
+        long long expected = cases.front().batch();
+        for (const BenchCase& bench : cases)
+        {
+            if (checked && bench.batch() != expected)
+            {
+                cout << "*** WARNING: " << kernel << " " << bench.backend << " differs from " << cases.front().backend << " on " << graph.name << " ***\n";
+                correct = false;
+            }
+            Timing timing = TimeBatch(bench.batch, repetitions);
+            cout << kernel << "; " << bench.backend << "; " << graph.name << "; " << graph.Size() << "; " << graph.Density() << "; "
+                << timing.median * 1e9 / ops << "; " << timing.min * 1e9 / ops << "; " << timing.max * 1e9 / ops << "; "
+                << items / timing.median << endl;
+        }
+    }
+
+    int repetitions;
+    string only;
+    vector<const BitKernels*> variants;
+    bool correct = true;
+};
+
+string GetBenchFolder()
+{
+    string path = __FILE__;
+    size_t found = path.find_last_of("\\/");
+    return path.substr(0, found);
+}
+
+int main(int argc, char* argv[])
+{
+    int repetitions = argc > 1 ? atoi(argv[1]) : 7;
+    string only = argc > 2 ? argv[2] : "";
+    vector<string> kernels = { "dimacs_read", "tightness", "candidate_filter", "first_fit", "check_coloring", "check_clique" };
+    if (repetitions < 1 || (!only.empty() && find(kernels.begin(), kernels.end(), only) == kernels.end()))
+    {
+        cout << "Usage: graph_bench [repetitions] [dimacs_read|tightness|candidate_filter|first_fit|check_coloring|check_clique]\n";
+        return 1;
+    }
+    string folder = GetBenchFolder();
+    vector<string> files = SelectInstances({
+        folder + "/../../bbound/cliques/brock400_2.clq", folder + "/../../bbound/cliques/p_hat1000-1.clq",
+        folder + "/../../vertexcolor/graphs/le450_15b.col", folder + "/../../vertexcolor/graphs/queen11_11.col"
+    });
+
+    cout << "Selected kernels: " << GetBitKernels().name << ", " << repetitions << " repetitions\n";
+    cout << "Kernel; Backend; Input; Vertices; Density; ns/op (median); ns/op (min); ns/op (max); Items/sec\n";
+    GraphBench bench(repetitions, only);
+    for (int n : { 128, 512, 1024 })
+    {
+        for (double p : { 0.1, 0.5, 0.9 })
+            bench.Run(RandomGraph(n, p));
+    }
+    for (const string& file : files)
+    {
+        string name = file.substr(file.find_last_of("\\/") + 1);
+        bench.Run(MakeBenchGraph(name, file, ReadDimacsGraph(file).neighbour_sets));
+    }
+    return bench.Correct() ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include "simd_kernels.h"
+using namespace std;
+
+// Microbenchmarks for every kernel of simd_kernels.h: each variant the CPU supports is run over
+// random rows of several widths, checked against the scalar result and reported in ns per call.
+
+volatile unsigned long long sink = 0;
+
+double TimeCalls(const function<long long()>& call, int repeats)
+{
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+        sink += call();
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / repeats;
+}
+
+int main()
+{
+    vector<const BitKernels*> variants = { &GetScalarKernels() };
+    if (CpuSupportsAvx2())
+        variants.push_back(&GetAvx2Kernels());
+    if (CpuSupportsAvx512())
+        variants.push_back(&GetAvx512Kernels());
+    cout << "Selected kernels: " << GetBitKernels().name << "\n";
+    cout << "Kernel; Words; Variant; ns per call\n";
+
+    mt19937_64 generator(1);
+    bool correct = true;
+    for (int words : { 2, 8, 16, 64, 256, 1024 })
+    {
+        vector<uint64_t> a(words), b(words), target(words);
+        for (int w = 0; w < words; ++w)
+        {
+            a[w] = generator() & generator();
+            b[w] = generator() | generator();
+        }
+        // first_set_bit has to scan most of the row
+        vector<uint64_t> sparse(words, 0);
+        sparse[words - 1] = uint64_t(1) << 17;
+        int repeats = max(1000, 4000000 / words);
+
+        // Sorted arrays with the same element count as the bits of a row at 50% density
+        int size = words * 32;
+        vector<int> x, y;
+        for (int v = 0; int(x.size()) < size; ++v)
+        {
+            if (generator() & 1)
+                x.push_back(v);
+        }
+        for (int v = 0; int(y.size()) < size; ++v)
+        {
+            if (generator() & 1)
+                y.push_back(v);
+        }
+
+        // Random adjacency matrix pointing to larger ids for set_edge_count, only for narrow rows
+        vector<uint64_t> matrix;
+        if (words <= 16)
+        {
+            matrix.assign(size_t(words) * 64 * words, 0);
+            for (int u = 0; u < words * 64; ++u)
+            {
+                for (int w = u / 64; w < words; ++w)
+                    matrix[size_t(u) * words + w] = generator() & generator() & (w == u / 64 ? ~uint64_t(0) << (u % 64) << 1 : ~uint64_t(0));
+            }
+        }
+
+        vector<pair<string, function<long long(const BitKernels&)>>> kernels = {
+            { "and", [&](const BitKernels& k) { k.and_rows(target.data(), a.data(), b.data(), words); return (long long)target[words / 2]; } },
+            { "andnot", [&](const BitKernels& k) { k.and_not_rows(target.data(), a.data(), b.data(), words); return (long long)target[words / 2]; } },
+            { "popcount", [&](const BitKernels& k) { return (long long)k.popcount_row(a.data(), words); } },
+            { "first_set_bit", [&](const BitKernels& k) { return (long long)k.first_set_bit(sparse.data(), words); } },
+            { "intersection_count", [&](const BitKernels& k) { return (long long)k.intersection_count(a.data(), b.data(), words); } },
+            { "sorted_intersection", [&](const BitKernels& k) { return (long long)k.sorted_intersection_count(x.data(), size, y.data(), size); } },
+        };
+        if (!matrix.empty())
+            kernels.push_back({ "set_edge_count", [&](const BitKernels& k) { return k.set_edge_count(a.data(), matrix.data(), 0, words); } });
+        for (auto& kernel : kernels)
+        {
+            long long expected = kernel.second(GetScalarKernels());
+            for (const BitKernels* variant : variants)
+            {
+                if (kernel.second(*variant) != expected)
+                {
+                    cout << "*** WARNING: " << kernel.first << " " << variant->name << " differs from scalar ***\n";
+                    correct = false;
+                }
+                double ns = TimeCalls([&] { return kernel.second(*variant); }, repeats);
+                cout << kernel.first << "; " << words << "; " << variant->name << "; " << ns << '\n';
+            }
+        }
+    }
+    return correct ? 0 : 1;
+}
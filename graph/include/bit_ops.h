@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Word-level bit helpers shared by the bitset code in every project
+
+inline int CountTrailingZeros(uint64_t word)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+inline int PopCount(uint64_t word)
+{
+#ifdef _MSC_VER
+    return int(__popcnt64(word));
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+inline int IntersectionCount(const uint64_t* a, const uint64_t* b, int words)
+{
+    int count = 0;
+    for (int w = 0; w < words; ++w)
+        count += PopCount(a[w] & b[w]);
+    return count;
+}
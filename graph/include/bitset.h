@@ -0,0 +1,156 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "bit_ops.h"
+#include "simd_kernels.h"
+
+// Applies f(0), ..., f(Words - 1) as one unrolled expression
+template <size_t... W, class F>
+inline void UnrolledWords(std::index_sequence<W...>, F&& f)
+{
+    (f(W), ...);
+}
+
+// Fixed-width vertex set for graphs with at most N vertices. The word count is a compile-time
+// constant, so every operation below is unrolled and the whole set can stay in registers.
+template <int N>
+class Bitset
+{
+public:
+    static_assert(N > 0 && N % 64 == 0, "Bitset width must be a multiple of 64");
+    static constexpr int kWords = N / 64;
+    using Words = std::make_index_sequence<kWords>;
+
+    // Same constructor as DynamicBitset, the size is only checked against N
+    explicit Bitset(int bits = N)
+    {
+        (void)bits;
+        UnrolledWords(Words{}, [&](size_t w) { words[w] = 0; });
+    }
+
+    void Set(int i) { words[i >> 6] |= uint64_t(1) << (i & 63); }
+    void Reset(int i) { words[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+    bool Test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+
+    Bitset& operator&=(const Bitset& other)
+    {
+        UnrolledWords(Words{}, [&](size_t w) { words[w] &= other.words[w]; });
+        return *this;
+    }
+
+    // this = a & b without a temporary
+    void AssignAnd(const Bitset& a, const Bitset& b)
+    {
+        UnrolledWords(Words{}, [&](size_t w) { words[w] = a.words[w] & b.words[w]; });
+    }
+
+    void AndNot(const Bitset& other)
+    {
+        UnrolledWords(Words{}, [&](size_t w) { words[w] &= ~other.words[w]; });
+    }
+
+    int Count() const
+    {
+        int count = 0;
+        UnrolledWords(Words{}, [&](size_t w) { count += PopCount(words[w]); });
+        return count;
+    }
+
+    int IntersectionCount(const Bitset& other) const
+    {
+        int count = 0;
+        UnrolledWords(Words{}, [&](size_t w) { count += PopCount(words[w] & other.words[w]); });
+        return count;
+    }
+
+    bool Any() const
+    {
+        uint64_t any = 0;
+        UnrolledWords(Words{}, [&](size_t w) { any |= words[w]; });
+        return any != 0;
+    }
+
+    // Lowest set bit, -1 for the empty set
+    int First() const
+    {
+        for (int w = 0; w < kWords; ++w)
+        {
+            if (words[w])
+                return w * 64 + CountTrailingZeros(words[w]);
+        }
+        return -1;
+    }
+
+private:
+    uint64_t words[kWords];
+};
+
+// Heap-backed vertex set with the same interface, used above the largest fixed width. Whole-row
+// operations go through the runtime-selected kernels of simd_kernels.h.
+class DynamicBitset
+{
+public:
+    explicit DynamicBitset(int bits = 0) : words((bits + 63) / 64, 0) {}
+
+    void Set(int i) { words[i >> 6] |= uint64_t(1) << (i & 63); }
+    void Reset(int i) { words[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+    bool Test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+
+    DynamicBitset& operator&=(const DynamicBitset& other)
+    {
+        GetBitKernels().and_rows(words.data(), words.data(), other.words.data(), words.size());
+        return *this;
+    }
+
+    void AssignAnd(const DynamicBitset& a, const DynamicBitset& b)
+    {
+        GetBitKernels().and_rows(words.data(), a.words.data(), b.words.data(), words.size());
+    }
+
+    void AndNot(const DynamicBitset& other)
+    {
+        GetBitKernels().and_not_rows(words.data(), words.data(), other.words.data(), words.size());
+    }
+
+    int Count() const
+    {
+        return GetBitKernels().popcount_row(words.data(), words.size());
+    }
+
+    int IntersectionCount(const DynamicBitset& other) const
+    {
+        return GetBitKernels().intersection_count(words.data(), other.words.data(), words.size());
+    }
+
+    bool Any() const
+    {
+        return First() != -1;
+    }
+
+    int First() const
+    {
+        return GetBitKernels().first_set_bit(words.data(), words.size());
+    }
+
+private:
+    std::vector<uint64_t> words;
+};
+
+// Calls f(Bitset<N>()) with the smallest fixed width that holds `vertices`, or f(DynamicBitset())
+// above 512. f is a generic lambda and gets instantiated once per width.
+template <class F>
+inline void DispatchBitset(int vertices, F&& f)
+{
+    if (vertices <= 64)
+        f(Bitset<64>());
+    else if (vertices <= 128)
+        f(Bitset<128>());
+    else if (vertices <= 256)
+        f(Bitset<256>());
+    else if (vertices <= 512)
+        f(Bitset<512>());
+    else
+        f(DynamicBitset(vertices));
+}
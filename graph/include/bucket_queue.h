@@ -0,0 +1,74 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <climits>
+
+// Vertices bucketed by an integer key. Insert, erase and key changes are O(1), the maximum
+// (minimum) is found by walking the top (bottom) pointer over empty buckets.
+class BucketQueue
+{
+public:
+    BucketQueue(int vertices, int max_key) : head(max_key + 1, -1), next(vertices, -1), prev(vertices, -1), key(vertices, -1) {}
+
+    bool Empty() const { return size == 0; }
+
+    bool Contains(int vertex) const { return key[vertex] != -1; }
+
+    void Insert(int vertex, int k)
+    {
+        key[vertex] = k;
+        prev[vertex] = -1;
+        next[vertex] = head[k];
+        if (head[k] != -1)
+            prev[head[k]] = vertex;
+        head[k] = vertex;
+        top = std::max(top, k);
+        bottom = std::min(bottom, k);
+        ++size;
+    }
+
+    void Erase(int vertex)
+    {
+        if (prev[vertex] != -1)
+            next[prev[vertex]] = next[vertex];
+        else
+            head[key[vertex]] = next[vertex];
+        if (next[vertex] != -1)
+            prev[next[vertex]] = prev[vertex];
+        key[vertex] = -1;
+        --size;
+    }
+
+    void ChangeKey(int vertex, int k)
+    {
+        Erase(vertex);
+        Insert(vertex, k);
+    }
+
+    int PopMax()
+    {
+        while (head[top] == -1)
+            --top;
+        int vertex = head[top];
+        Erase(vertex);
+        return vertex;
+    }
+
+    int PopMin()
+    {
+        while (head[bottom] == -1)
+            ++bottom;
+        int vertex = head[bottom];
+        Erase(vertex);
+        return vertex;
+    }
+
+private:
+    std::vector<int> head;
+    std::vector<int> next;
+    std::vector<int> prev;
+    std::vector<int> key;
+    int top = -1;
+    int bottom = INT_MAX;
+    int size = 0;
+};
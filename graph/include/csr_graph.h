@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
+#include "simd_kernels.h"
+
+// Neighbour lists flattened into one array: neighbours of v are targets[offsets[v]..offsets[v + 1])
+struct CsrGraph
+{
+    std::vector<int> offsets;
+    std::vector<int> targets;
+
+    int Size() const { return int(offsets.size()) - 1; }
+    int Degree(int v) const { return offsets[v + 1] - offsets[v]; }
+};
+
+// CSR form of the adjacency sets the solvers read from DIMACS files, every neighbour list sorted
+inline CsrGraph BuildCsrGraph(const std::vector<std::unordered_set<int>>& neighbour_sets)
+{
+    int n = neighbour_sets.size();
+    CsrGraph graph;
+    graph.offsets.assign(n + 1, 0);
+    for (int i = 0; i < n; ++i)
+        graph.offsets[i + 1] = graph.offsets[i] + neighbour_sets[i].size();
+    graph.targets.resize(graph.offsets[n]);
+    for (int i = 0; i < n; ++i)
+    {
+        std::copy(neighbour_sets[i].begin(), neighbour_sets[i].end(), graph.targets.begin() + graph.offsets[i]);
+        std::sort(graph.targets.begin() + graph.offsets[i], graph.targets.begin() + graph.offsets[i + 1]);
+    }
+    return graph;
+}
+
+// Number of common neighbours of u and v, an intersection of two sorted CSR rows
+inline int CommonNeighbourCount(const CsrGraph& graph, int u, int v)
+{
+    return GetBitKernels().sorted_intersection_count(graph.targets.data() + graph.offsets[u], graph.Degree(u),
+        graph.targets.data() + graph.offsets[v], graph.Degree(v));
+}
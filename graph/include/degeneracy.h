@@ -0,0 +1,49 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include "csr_graph.h"
+#include "bucket_queue.h"
+
+// Core decomposition (Matula, Beck). order is the smallest-last removal order, so every vertex has
+// at most `degeneracy` neighbours after it in the order. core[v] is the largest k such that v
+// belongs to the k-core; a vertex of a clique of size q has core number at least q - 1.
+struct CoreDecomposition
+{
+    std::vector<int> order;
+    std::vector<int> core;
+    int degeneracy = 0;
+};
+
+// Repeatedly removes a vertex of minimum remaining degree from a bucket queue, O(n + m)
+inline CoreDecomposition ComputeCoreDecomposition(const CsrGraph& graph)
+{
+    int n = graph.Size();
+    CoreDecomposition result;
+    result.order.resize(n);
+    result.core.resize(n);
+    std::vector<int> key(n);
+    int max_degree = 0;
+    for (int v = 0; v < n; ++v)
+    {
+        key[v] = graph.Degree(v);
+        max_degree = std::max(max_degree, key[v]);
+    }
+
+    BucketQueue queue(n, max_degree);
+    for (int v = 0; v < n; ++v)
+        queue.Insert(v, key[v]);
+    for (int i = 0; i < n; ++i)
+    {
+        int v = queue.PopMin();
+        result.degeneracy = std::max(result.degeneracy, key[v]);
+        result.core[v] = result.degeneracy;
+        result.order[i] = v;
+        for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+        {
+            int u = graph.targets[e];
+            if (queue.Contains(u))
+                queue.ChangeKey(u, --key[u]);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+// Graph of a DIMACS .clq/.col file: "p edge <vertices> <edges>", "e <u> <v>" and, in weighted
+// instances, "n <v> <w>" lines with 1-based vertices; "c" lines are comments.
+struct DimacsGraph
+{
+    std::vector<std::unordered_set<int>> neighbour_sets;
+    // Empty unless the file has "n" lines, vertices without one weigh 1
+    std::vector<int> vertex_weights;
+};
+
+// 0-based neighbour sets, repeated edges collapse. A file that cannot be read gives an empty graph.
+// Compiled once into modernop_graph for all the solvers.
+DimacsGraph ReadDimacsGraph(const std::string& filename);
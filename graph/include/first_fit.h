@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "bit_ops.h"
+
+// First-fit color choice without allocations. Neighbour colors are marked in a bitmask (color c is
+// bit c - 1, colors above max_degree + 1 can never be the answer and are skipped), the lowest free
+// color is found with count-trailing-zeros and only the words that were touched are cleared again.
+class FirstFitKernel
+{
+public:
+    explicit FirstFitKernel(int max_degree) : used((max_degree + 1) / 64 + 1, 0) {}
+
+    int Choose(const int* neighbours, int count, const int* colors)
+    {
+        int limit = used.size() * 64;
+        int top_word = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            int color = colors[neighbours[i]];
+            if (color == 0 || color > limit)
+                continue;
+            used[(color - 1) / 64] |= uint64_t(1) << ((color - 1) % 64);
+            top_word = std::max(top_word, (color - 1) / 64);
+        }
+        int word = 0;
+        while (used[word] == ~uint64_t(0))
+            ++word;
+        int color = word * 64 + CountTrailingZeros(~used[word]) + 1;
+        std::fill(used.begin(), used.begin() + top_word + 1, 0);
+        return color;
+    }
+
+private:
+    std::vector<uint64_t> used;
+};
@@ -0,0 +1,253 @@
+#pragma once
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
+#include "bucket_queue.h"
+#include "reduction.h"
+
+// Above this many vertices a kernel component is not searched exactly, the greedy set is kept
+constexpr int kIndependentSetBnBLimit = 1024;
+
+// Degree-2 fold: v had exactly the two non-adjacent neighbours u and w, which were merged into the
+// new vertex `folded` with N(folded) = N(u) + N(w) - v. The independence number drops by one.
+struct DegreeTwoFold
+{
+    int v;
+    int u;
+    int w;
+    int folded;
+};
+
+// What is left of the maximum independent set problem after the degree-0/1/2 rules. Working ids
+// below `vertices` are the input vertices, the ones above are folded vertices. The kernel is
+// relabelled 0..k-1 and kernel_ids maps it back to working ids.
+struct IndependentSetReduction
+{
+    std::vector<std::unordered_set<int>> neighbour_sets;
+    std::vector<int> kernel_ids;
+    std::vector<int> taken;
+    std::vector<DegreeTwoFold> folds;
+    int vertices = 0;
+    int working_vertices = 0;
+    ReductionStats stats;
+
+    // Independent set of the input graph from one of the kernel: folds are undone in reverse, a
+    // folded vertex in the set gives u and w, otherwise v joins
+    std::vector<int> Lift(const std::vector<int>& kernel_set) const
+    {
+        std::vector<char> in_set(working_vertices, 0);
+        for (int v : taken)
+            in_set[v] = 1;
+        for (int v : kernel_set)
+            in_set[kernel_ids[v]] = 1;
+        for (auto fold = folds.rbegin(); fold != folds.rend(); ++fold)
+        {
+            if (in_set[fold->folded])
+            {
+                in_set[fold->folded] = 0;
+                in_set[fold->u] = in_set[fold->w] = 1;
+            }
+            else
+            {
+                in_set[fold->v] = 1;
+            }
+        }
+        std::vector<int> result;
+        for (int v = 0; v < vertices; ++v)
+        {
+            if (in_set[v])
+                result.push_back(v);
+        }
+        return result;
+    }
+};
+
+// Exhaustive degree-0/1/2 reductions, each of them keeps a maximum independent set: an isolated
+// vertex is taken, a degree-1 vertex is taken instead of its neighbour, a degree-2 vertex in a
+// triangle is taken instead of both neighbours, and otherwise it is folded with them. Only vertices
+// whose degree dropped are looked at again, so the whole pass is linear in the edges it touches.
+inline IndependentSetReduction ReduceForIndependentSet(const std::vector<std::unordered_set<int>>& neighbour_sets)
+{
+    int n = neighbour_sets.size();
+    IndependentSetReduction result;
+    std::vector<std::unordered_set<int>> graph = neighbour_sets;
+    std::vector<char> alive(n, 1);
+    std::vector<int> pending;
+    auto remove = [&](int v) {
+        for (int u : graph[v])
+        {
+            graph[u].erase(v);
+            if (graph[u].size() <= 2)
+                pending.push_back(u);
+        }
+        graph[v].clear();
+        alive[v] = 0;
+    };
+
+    // A vertex with a self-loop is in no independent set
+    for (int v = 0; v < n; ++v)
+    {
+        result.stats.edges_before += graph[v].size();
+        if (graph[v].erase(v))
+            remove(v);
+    }
+    for (int v = 0; v < n; ++v)
+    {
+        if (alive[v] && graph[v].size() <= 2)
+            pending.push_back(v);
+    }
+
+    while (!pending.empty())
+    {
+        int v = pending.back();
+        pending.pop_back();
+        if (!alive[v] || graph[v].size() > 2)
+            continue;
+        if (graph[v].size() == 0)
+        {
+            result.taken.push_back(v);
+            alive[v] = 0;
+        }
+        else if (graph[v].size() == 1)
+        {
+            int u = *graph[v].begin();
+            result.taken.push_back(v);
+            remove(v);
+            remove(u);
+        }
+        else
+        {
+            auto it = graph[v].begin();
+            int u = *it++;
+            int w = *it;
+            if (graph[u].count(w))
+            {
+                result.taken.push_back(v);
+                remove(v);
+                remove(u);
+                remove(w);
+                continue;
+            }
+            int folded = graph.size();
+            std::unordered_set<int> merged;
+            for (int x : graph[u])
+                merged.insert(x);
+            for (int x : graph[w])
+                merged.insert(x);
+            merged.erase(v);
+            result.folds.push_back({v, u, w, folded});
+            remove(v);
+            remove(u);
+            remove(w);
+            graph.push_back(std::unordered_set<int>());
+            alive.push_back(1);
+            for (int x : merged)
+            {
+                graph[folded].insert(x);
+                graph[x].insert(folded);
+            }
+            if (graph[folded].size() <= 2)
+                pending.push_back(folded);
+        }
+    }
+
+    int working = graph.size();
+    std::vector<int> new_id(working, -1);
+    for (int v = 0; v < working; ++v)
+    {
+        if (alive[v])
+        {
+            new_id[v] = result.kernel_ids.size();
+            result.kernel_ids.push_back(v);
+        }
+    }
+    int kept = result.kernel_ids.size();
+    result.neighbour_sets.resize(kept);
+    for (int i = 0; i < kept; ++i)
+    {
+        for (int u : graph[result.kernel_ids[i]])
+            result.neighbour_sets[i].insert(new_id[u]);
+        result.stats.edges_after += result.neighbour_sets[i].size();
+    }
+    result.vertices = n;
+    result.working_vertices = working;
+    result.stats.vertices_before = n;
+    result.stats.vertices_after = kept;
+    result.stats.edges_before /= 2;
+    result.stats.edges_after /= 2;
+    return result;
+}
+
+// Connected components as induced subgraphs, original_ids maps each back to the input graph
+inline std::vector<CliqueReduction> SplitComponents(const std::vector<std::unordered_set<int>>& neighbour_sets)
+{
+    int n = neighbour_sets.size();
+    std::vector<CliqueReduction> components;
+    std::vector<int> local_id(n, -1);
+    for (int root = 0; root < n; ++root)
+    {
+        if (local_id[root] != -1)
+            continue;
+        CliqueReduction component;
+        local_id[root] = 0;
+        component.original_ids.push_back(root);
+        for (size_t next = 0; next < component.original_ids.size(); ++next)
+        {
+            for (int u : neighbour_sets[component.original_ids[next]])
+            {
+                if (local_id[u] == -1)
+                {
+                    local_id[u] = component.original_ids.size();
+                    component.original_ids.push_back(u);
+                }
+            }
+        }
+        int size = component.original_ids.size();
+        component.neighbour_sets.resize(size);
+        for (int i = 0; i < size; ++i)
+        {
+            for (int u : neighbour_sets[component.original_ids[i]])
+                component.neighbour_sets[i].insert(local_id[u]);
+            component.stats.edges_after += component.neighbour_sets[i].size();
+        }
+        component.stats.vertices_before = component.stats.vertices_after = size;
+        component.stats.edges_after /= 2;
+        component.stats.edges_before = component.stats.edges_after;
+        components.push_back(std::move(component));
+    }
+    return components;
+}
+
+// Minimum-degree greedy: take a vertex of the lowest remaining degree, drop its neighbours, repeat
+inline std::vector<int> GreedyIndependentSet(const std::vector<std::unordered_set<int>>& neighbour_sets)
+{
+    int n = neighbour_sets.size();
+    std::vector<int> degree(n);
+    int max_degree = 0;
+    for (int v = 0; v < n; ++v)
+    {
+        degree[v] = neighbour_sets[v].size();
+        max_degree = std::max(max_degree, degree[v]);
+    }
+    BucketQueue queue(n, max_degree);
+    for (int v = 0; v < n; ++v)
+        queue.Insert(v, degree[v]);
+    std::vector<int> result;
+    while (!queue.Empty())
+    {
+        int v = queue.PopMin();
+        result.push_back(v);
+        for (int u : neighbour_sets[v])
+        {
+            if (!queue.Contains(u))
+                continue;
+            queue.Erase(u);
+            for (int x : neighbour_sets[u])
+            {
+                if (queue.Contains(x))
+                    queue.ChangeKey(x, --degree[x]);
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Settings of one solver run that come from the environment, so that scripts (the PGO training run,
+// the suite runner) can drive the solvers without depending on where the binary was built.
+
+// Instance files: MODERNOP_INSTANCES, a list of paths separated by ';', replaces the built-in list
+std::vector<std::string> SelectInstances(const std::vector<std::string>& defaults);
+
+// Seed for the random generators of a run: MODERNOP_SEED if it is set, else the solver's own default
+unsigned RunSeed(unsigned fallback = 5489u);
+
+// Appends "<problem>;<instance>;<value>" to the file named by MODERNOP_RESULTS, if it is set. The
+// value is the objective of the solution found: clique size or weight, number of colours,
+// independent set size.
+void ReportResult(const std::string& problem, const std::string& instance, long long value);
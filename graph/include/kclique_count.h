@@ -0,0 +1,303 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include "csr_graph.h"
+#include "degeneracy.h"
+#include "bit_ops.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+
+// Roots with at most this many out-neighbours count on a local bitset adjacency, above it on sorted arrays
+constexpr int kCliqueCountBitsetLimit = 4096;
+
+// Clique counts by size: counts[s] is the number of s-cliques for 1 <= s <= max_k. With per_vertex,
+// participation[v] is the number of max_k-cliques containing v.
+struct CliqueCounts
+{
+    std::vector<long long> counts;
+    std::vector<long long> participation;
+};
+
+// The graph renumbered so that vertex i is order[i], with every edge oriented towards the larger
+// id. Along a degeneracy order every vertex keeps at most `degeneracy` out-neighbours and every
+// clique is listed once, from its first vertex. Out-neighbour lists are sorted.
+inline CsrGraph DegeneracyDag(const CsrGraph& graph, const std::vector<int>& order)
+{
+    int n = graph.Size();
+    std::vector<int> position(n);
+    for (int i = 0; i < n; ++i)
+        position[order[i]] = i;
+    CsrGraph dag;
+    dag.offsets.assign(n + 1, 0);
+    for (int i = 0; i < n; ++i)
+    {
+        int v = order[i];
+        for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+            dag.offsets[i + 1] += position[graph.targets[e]] > i;
+    }
+    for (int i = 0; i < n; ++i)
+        dag.offsets[i + 1] += dag.offsets[i];
+    dag.targets.resize(dag.offsets[n]);
+    for (int i = 0; i < n; ++i)
+    {
+        int v = order[i];
+        int next = dag.offsets[i];
+        for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+        {
+            if (position[graph.targets[e]] > i)
+                dag.targets[next++] = position[graph.targets[e]];
+        }
+        std::sort(dag.targets.begin() + dag.offsets[i], dag.targets.begin() + next);
+    }
+    return dag;
+}
+
+// kClist for the roots owned by one thread. The candidate set of a clique with s vertices holds
+// their common out-neighbours, its size is the number of (s + 1)-cliques extending it. At
+// s = max_k - 2 the edges inside it are counted instead of listed, so neither (max_k - 1)- nor
+// max_k-cliques are ever materialized.
+class CliqueCountWorker
+{
+public:
+    CliqueCountWorker(const CsrGraph& dag, int max_k, bool per_vertex)
+        : dag(dag), kernels(GetBitKernels()), max_k(max_k), per_vertex(per_vertex), counts(max_k + 1, 0),
+        participation(per_vertex ? dag.Size() : 0, 0), local_index(dag.Size(), -1)
+    {
+    }
+
+    void Run(int v)
+    {
+        clique.assign(1, v);
+        if (max_k == 1)
+        {
+            if (per_vertex)
+                ++participation[v];
+            return;
+        }
+        counts[2] += dag.Degree(v);
+        if (max_k == 2)
+        {
+            if (per_vertex)
+            {
+                participation[v] += dag.Degree(v);
+                for (int e = dag.offsets[v]; e < dag.offsets[v + 1]; ++e)
+                    ++participation[dag.targets[e]];
+            }
+            return;
+        }
+        if (dag.Degree(v) >= 2)
+        {
+            if (dag.Degree(v) <= kCliqueCountBitsetLimit)
+                RunBitsets(v);
+            else
+                RunSorted(v);
+        }
+    }
+
+    const std::vector<long long>& Counts() const { return counts; }
+    const std::vector<long long>& Participation() const { return participation; }
+
+private:
+    const int* Row(int v) const { return dag.targets.data() + dag.offsets[v]; }
+
+    void AddToClique(long long cliques)
+    {
+        for (int v : clique)
+            participation[v] += cliques;
+    }
+
+    // Local ids are positions in the sorted out-neighbour list of the root, so row i only has bits
+    // above i and every candidate set lies above the vertex it was branched on: all row operations
+    // start at that vertex's word. Arena level s holds the candidate set of the cliques with s
+    // vertices. Rows go through the runtime-selected kernels, which have hardware popcount even
+    // when the build does not enable it.
+    void RunBitsets(int v)
+    {
+        int m = dag.Degree(v);
+        local = Row(v);
+        words_per_set = (m + 63) / 64;
+        for (int i = 0; i < m; ++i)
+            local_index[local[i]] = i;
+        rows.assign(size_t(m) * words_per_set, 0);
+        for (int i = 0; i < m; ++i)
+        {
+            uint64_t* row = rows.data() + size_t(i) * words_per_set;
+            for (int e = dag.offsets[local[i]]; e < dag.offsets[local[i] + 1]; ++e)
+            {
+                int j = local_index[dag.targets[e]];
+                if (j >= 0)
+                    row[j >> 6] |= uint64_t(1) << (j & 63);
+            }
+        }
+        for (int i = 0; i < m; ++i)
+            local_index[local[i]] = -1;
+
+        arena.assign(size_t(max_k) * words_per_set, 0);
+        uint64_t* candidates = arena.data() + words_per_set;
+        for (int i = 0; i < m; ++i)
+            candidates[i >> 6] |= uint64_t(1) << (i & 63);
+        ExpandBitsets(1, 0);
+    }
+
+    void ExpandBitsets(int size, int first_word)
+    {
+        int words = words_per_set;
+        const uint64_t* candidates = arena.data() + size_t(size) * words;
+        if (size + 2 == max_k)
+        {
+            long long edges = kernels.set_edge_count(candidates, rows.data(), first_word, words);
+            counts[max_k] += edges;
+            if (per_vertex && edges > 0)
+            {
+                AddToClique(edges);
+                for (int w = first_word; w < words; ++w)
+                {
+                    for (uint64_t bits = candidates[w]; bits; bits &= bits - 1)
+                    {
+                        int u = w * 64 + CountTrailingZeros(bits);
+                        const uint64_t* row = rows.data() + size_t(u) * words;
+                        for (int x = w; x < words; ++x)
+                        {
+                            for (uint64_t common = candidates[x] & row[x]; common; common &= common - 1)
+                            {
+                                ++participation[local[u]];
+                                ++participation[local[x * 64 + CountTrailingZeros(common)]];
+                            }
+                        }
+                    }
+                }
+            }
+            return;
+        }
+
+        uint64_t* next = arena.data() + size_t(size + 1) * words;
+        for (int w = first_word; w < words; ++w)
+        {
+            for (uint64_t bits = candidates[w]; bits; bits &= bits - 1)
+            {
+                int u = w * 64 + CountTrailingZeros(bits);
+                kernels.and_rows(next + w, candidates + w, rows.data() + size_t(u) * words + w, words - w);
+                int next_count = kernels.popcount_row(next + w, words - w);
+                counts[size + 2] += next_count;
+                if (next_count > 0)
+                {
+                    clique.push_back(local[u]);
+                    ExpandBitsets(size + 1, w);
+                    clique.pop_back();
+                }
+            }
+        }
+    }
+
+    // Hub roots: candidate sets as sorted vertex lists, the last level counted with the sorted
+    // intersection kernel
+    void RunSorted(int v)
+    {
+        if (int(sorted.size()) < max_k)
+            sorted.resize(max_k);
+        sorted[1].assign(Row(v), Row(v) + dag.Degree(v));
+        ExpandSorted(1);
+    }
+
+    void ExpandSorted(int size)
+    {
+        const std::vector<int>& candidates = sorted[size];
+        if (size + 2 == max_k)
+        {
+            long long edges = 0;
+            for (int u : candidates)
+            {
+                int out = kernels.sorted_intersection_count(candidates.data(), candidates.size(), Row(u), dag.Degree(u));
+                edges += out;
+                if (per_vertex && out > 0)
+                {
+                    participation[u] += out;
+                    std::vector<int>& common = sorted[size + 1];
+                    common.clear();
+                    std::set_intersection(candidates.begin(), candidates.end(), Row(u), Row(u) + dag.Degree(u), std::back_inserter(common));
+                    for (int w : common)
+                        ++participation[w];
+                }
+            }
+            counts[max_k] += edges;
+            if (per_vertex)
+                AddToClique(edges);
+            return;
+        }
+
+        for (int u : candidates)
+        {
+            std::vector<int>& next = sorted[size + 1];
+            next.clear();
+            std::set_intersection(candidates.begin(), candidates.end(), Row(u), Row(u) + dag.Degree(u), std::back_inserter(next));
+            counts[size + 2] += next.size();
+            if (!next.empty())
+            {
+                clique.push_back(u);
+                ExpandSorted(size + 1);
+                clique.pop_back();
+            }
+        }
+    }
+
+    const CsrGraph& dag;
+    const BitKernels& kernels;
+    int max_k;
+    bool per_vertex;
+    std::vector<long long> counts;
+    std::vector<long long> participation;
+    std::vector<int> clique;
+    std::vector<int> local_index;
+    const int* local = nullptr;
+    int words_per_set = 0;
+    std::vector<uint64_t> rows;
+    std::vector<uint64_t> arena;
+    std::vector<std::vector<int>> sorted;
+};
+
+// Number of cliques of every size up to max_k, roots distributed over `threads` workers of a
+// ThreadPool largest out-degree first
+inline CliqueCounts CountCliques(const CsrGraph& graph, int max_k, int threads, bool per_vertex = false)
+{
+    int n = graph.Size();
+    CliqueCounts result;
+    result.counts.assign(max_k + 1, 0);
+    result.participation.assign(per_vertex ? n : 0, 0);
+    if (max_k < 1)
+        return result;
+    result.counts[1] = n;
+
+    std::vector<int> order = ComputeCoreDecomposition(graph).order;
+    CsrGraph dag = DegeneracyDag(graph, order);
+    std::vector<int> roots(n);
+    for (int i = 0; i < n; ++i)
+        roots[i] = i;
+    std::stable_sort(roots.begin(), roots.end(), [&](int a, int b) { return dag.Degree(a) > dag.Degree(b); });
+
+    threads = std::max(1, threads);
+    std::atomic<int> next(0);
+    std::vector<CliqueCounts> partial(threads);
+    ThreadPool pool(threads);
+    for (int t = 0; t < threads; ++t)
+    {
+        pool.Submit([&, t] {
+            CliqueCountWorker worker(dag, max_k, per_vertex);
+            for (int i = next++; i < n; i = next++)
+                worker.Run(roots[i]);
+            partial[t].counts = worker.Counts();
+            partial[t].participation = worker.Participation();
+        });
+    }
+    pool.Wait();
+    for (const CliqueCounts& counts : partial)
+    {
+        for (int s = 2; s <= max_k; ++s)
+            result.counts[s] += counts.counts[s];
+        for (size_t i = 0; i < counts.participation.size(); ++i)
+            result.participation[order[i]] += counts.participation[i];
+    }
+    return result;
+}
@@ -0,0 +1,256 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include "csr_graph.h"
+#include "degeneracy.h"
+#include "bit_ops.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+
+// Outer subproblems with at most this many vertices in P and X together are solved on bitsets over
+// the vertex's neighbourhood (a quadratic adjacency matrix); larger ones work on sorted arrays
+constexpr int kMaximalCliqueBitsetLimit = 4096;
+
+// Bron-Kerbosch with Tomita pivoting for the outer subproblems owned by one thread. Outer vertex v
+// starts with P = its neighbours later in the degeneracy order and X = the earlier ones, so every
+// maximal clique is reported once, from its first vertex in that order.
+template <class Sink>
+class MaximalCliqueWorker
+{
+public:
+    MaximalCliqueWorker(const CsrGraph& graph, const std::vector<int>& position, int degeneracy, int worker, Sink& sink)
+        : graph(graph), position(position), kernels(GetBitKernels()), degeneracy(degeneracy), worker(worker), sink(sink),
+        local_index(graph.Size(), -1)
+    {
+    }
+
+    void Run(int v)
+    {
+        clique.assign(1, v);
+        if (graph.Degree(v) <= kMaximalCliqueBitsetLimit)
+            RunBitsets(v);
+        else
+            RunSorted(v);
+    }
+
+    long long Cliques() const { return cliques; }
+
+private:
+    const int* Row(int v) const { return graph.targets.data() + graph.offsets[v]; }
+
+    void Report()
+    {
+        ++cliques;
+        sink(worker, clique);
+    }
+
+    // Local ids are the positions in the sorted neighbour list of v. The arena holds P, X and the
+    // branch set of every depth, words_per_set words each.
+    void RunBitsets(int v)
+    {
+        int m = graph.Degree(v);
+        const int* local = Row(v);
+        words_per_set = (m + 63) / 64;
+        for (int i = 0; i < m; ++i)
+            local_index[local[i]] = i;
+        rows.assign(size_t(m) * words_per_set, 0);
+        for (int i = 0; i < m; ++i)
+        {
+            uint64_t* row = rows.data() + size_t(i) * words_per_set;
+            for (int e = graph.offsets[local[i]]; e < graph.offsets[local[i] + 1]; ++e)
+            {
+                int j = local_index[graph.targets[e]];
+                if (j >= 0)
+                    row[j >> 6] |= uint64_t(1) << (j & 63);
+            }
+        }
+        for (int i = 0; i < m; ++i)
+            local_index[local[i]] = -1;
+
+        arena.assign(size_t(std::min(m, degeneracy) + 2) * 3 * words_per_set, 0);
+        uint64_t* p = arena.data();
+        uint64_t* x = p + words_per_set;
+        for (int i = 0; i < m; ++i)
+        {
+            uint64_t* set = position[local[i]] > position[v] ? p : x;
+            set[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+        ExpandBitsets(0, local);
+    }
+
+    void ExpandBitsets(int depth, const int* local)
+    {
+        int words = words_per_set;
+        uint64_t* p = arena.data() + size_t(depth) * 3 * words;
+        uint64_t* x = p + words;
+        uint64_t* branch = x + words;
+        int p_count = kernels.popcount_row(p, words);
+        if (p_count == 0)
+        {
+            if (kernels.first_set_bit(x, words) == -1)
+                Report();
+            return;
+        }
+
+        // Tomita pivot: the vertex of P or X with the most neighbours in P
+        int pivot = -1;
+        int pivot_count = -1;
+        for (int w = 0; w < words && pivot_count < p_count; ++w)
+        {
+            for (uint64_t bits = p[w] | x[w]; bits && pivot_count < p_count; bits &= bits - 1)
+            {
+                int u = w * 64 + CountTrailingZeros(bits);
+                int count = kernels.intersection_count(p, rows.data() + size_t(u) * words, words);
+                if (count > pivot_count)
+                {
+                    pivot = u;
+                    pivot_count = count;
+                }
+            }
+        }
+
+        kernels.and_not_rows(branch, p, rows.data() + size_t(pivot) * words, words);
+        uint64_t* next_p = p + 3 * words;
+        uint64_t* next_x = next_p + words;
+        for (int w = 0; w < words; ++w)
+        {
+            for (uint64_t bits = branch[w]; bits; bits &= bits - 1)
+            {
+                int u = w * 64 + CountTrailingZeros(bits);
+                const uint64_t* row = rows.data() + size_t(u) * words;
+                kernels.and_rows(next_p, p, row, words);
+                kernels.and_rows(next_x, x, row, words);
+                clique.push_back(local[u]);
+                ExpandBitsets(depth + 1, local);
+                clique.pop_back();
+                p[w] &= ~(uint64_t(1) << (u & 63));
+                x[w] |= uint64_t(1) << (u & 63);
+            }
+        }
+    }
+
+    // Hub vertices: P and X as sorted vertex lists, intersected with the sorted CSR rows
+    void RunSorted(int v)
+    {
+        int depths = std::min(graph.Degree(v), degeneracy) + 2;
+        if (int(sorted_p.size()) < depths)
+        {
+            sorted_p.resize(depths);
+            sorted_x.resize(depths);
+            sorted_branch.resize(depths);
+        }
+        sorted_p[0].clear();
+        sorted_x[0].clear();
+        for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+        {
+            int u = graph.targets[e];
+            (position[u] > position[v] ? sorted_p[0] : sorted_x[0]).push_back(u);
+        }
+        ExpandSorted(0);
+    }
+
+    void ExpandSorted(int depth)
+    {
+        std::vector<int>& p = sorted_p[depth];
+        std::vector<int>& x = sorted_x[depth];
+        if (p.empty())
+        {
+            if (x.empty())
+                Report();
+            return;
+        }
+
+        int pivot = -1;
+        int pivot_count = -1;
+        for (const std::vector<int>* set : {&p, &x})
+        {
+            for (int u : *set)
+            {
+                int count = kernels.sorted_intersection_count(p.data(), p.size(), Row(u), graph.Degree(u));
+                if (count > pivot_count)
+                {
+                    pivot = u;
+                    pivot_count = count;
+                }
+            }
+        }
+
+        std::vector<int>& branch = sorted_branch[depth];
+        branch.clear();
+        std::set_difference(p.begin(), p.end(), Row(pivot), Row(pivot) + graph.Degree(pivot), std::back_inserter(branch));
+        for (int u : branch)
+        {
+            std::vector<int>& next_p = sorted_p[depth + 1];
+            std::vector<int>& next_x = sorted_x[depth + 1];
+            next_p.clear();
+            next_x.clear();
+            std::set_intersection(p.begin(), p.end(), Row(u), Row(u) + graph.Degree(u), std::back_inserter(next_p));
+            std::set_intersection(x.begin(), x.end(), Row(u), Row(u) + graph.Degree(u), std::back_inserter(next_x));
+            clique.push_back(u);
+            ExpandSorted(depth + 1);
+            clique.pop_back();
+            p.erase(std::lower_bound(p.begin(), p.end(), u));
+            x.insert(std::lower_bound(x.begin(), x.end(), u), u);
+        }
+    }
+
+    const CsrGraph& graph;
+    const std::vector<int>& position;
+    const BitKernels& kernels;
+    int degeneracy;
+    int worker;
+    Sink& sink;
+    long long cliques = 0;
+    std::vector<int> clique;
+    std::vector<int> local_index;
+    int words_per_set = 0;
+    std::vector<uint64_t> rows;
+    std::vector<uint64_t> arena;
+    std::vector<std::vector<int>> sorted_p;
+    std::vector<std::vector<int>> sorted_x;
+    std::vector<std::vector<int>> sorted_branch;
+};
+
+// Calls sink(worker, clique) for every maximal clique of the graph and returns their number.
+// Outer vertices are handed out largest subproblem first to `threads` workers of a ThreadPool;
+// one worker's calls are sequential, different workers call the sink concurrently.
+template <class Sink>
+inline long long ForEachMaximalClique(const CsrGraph& graph, int threads, Sink&& sink)
+{
+    int n = graph.Size();
+    CoreDecomposition cores = ComputeCoreDecomposition(graph);
+    std::vector<int> position(n);
+    for (int i = 0; i < n; ++i)
+        position[cores.order[i]] = i;
+    std::vector<int> later(n, 0);
+    for (int v = 0; v < n; ++v)
+    {
+        for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+            later[v] += position[graph.targets[e]] > position[v];
+    }
+    std::vector<int> outer = cores.order;
+    std::stable_sort(outer.begin(), outer.end(), [&](int a, int b) { return later[a] > later[b]; });
+
+    threads = std::max(1, threads);
+    std::atomic<int> next(0);
+    std::vector<long long> cliques(threads, 0);
+    ThreadPool pool(threads);
+    for (int t = 0; t < threads; ++t)
+    {
+        pool.Submit([&, t] {
+            MaximalCliqueWorker<typename std::remove_reference<Sink>::type> worker(graph, position, cores.degeneracy, t, sink);
+            for (int i = next++; i < n; i = next++)
+                worker.Run(outer[i]);
+            cliques[t] = worker.Cliques();
+        });
+    }
+    pool.Wait();
+    long long total = 0;
+    for (long long count : cliques)
+        total += count;
+    return total;
+}
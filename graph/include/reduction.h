@@ -0,0 +1,106 @@
+#pragma once
+#include <vector>
+#include <unordered_set>
+#include "csr_graph.h"
+#include "degeneracy.h"
+
+struct ReductionStats
+{
+    int vertices_before = 0;
+    int vertices_after = 0;
+    long long edges_before = 0;
+    long long edges_after = 0;
+};
+
+// Induced subgraph on the kept vertices, relabelled 0..k-1; original_ids maps a new id back
+struct CliqueReduction
+{
+    std::vector<std::unordered_set<int>> neighbour_sets;
+    std::vector<int> original_ids;
+    ReductionStats stats;
+};
+
+// Induced subgraph on the vertices with keep[v], filled into a CliqueReduction
+inline CliqueReduction InduceKeptVertices(const std::vector<std::unordered_set<int>>& neighbour_sets, const std::vector<bool>& keep)
+{
+    int n = neighbour_sets.size();
+    CliqueReduction result;
+    std::vector<int> new_id(n, -1);
+    for (int v = 0; v < n; ++v)
+    {
+        result.stats.edges_before += neighbour_sets[v].size();
+        if (keep[v])
+        {
+            new_id[v] = result.original_ids.size();
+            result.original_ids.push_back(v);
+        }
+    }
+
+    int kept = result.original_ids.size();
+    result.neighbour_sets.resize(kept);
+    for (int i = 0; i < kept; ++i)
+    {
+        for (int u : neighbour_sets[result.original_ids[i]])
+        {
+            if (new_id[u] != -1)
+                result.neighbour_sets[i].insert(new_id[u]);
+        }
+        result.stats.edges_after += result.neighbour_sets[i].size();
+    }
+    result.stats.vertices_before = n;
+    result.stats.vertices_after = kept;
+    result.stats.edges_before /= 2;
+    result.stats.edges_after /= 2;
+    return result;
+}
+
+// Keeps only vertices that can be in a clique with more than `incumbent` vertices: such a vertex has
+// core number at least `incumbent`. Dropping everything below is the same as repeatedly deleting
+// vertices of degree < incumbent until none is left.
+inline CliqueReduction ReduceForClique(const std::vector<std::unordered_set<int>>& neighbour_sets, int incumbent)
+{
+    int n = neighbour_sets.size();
+    CoreDecomposition cores = ComputeCoreDecomposition(BuildCsrGraph(neighbour_sets));
+    std::vector<bool> keep(n);
+    for (int v = 0; v < n; ++v)
+        keep[v] = cores.core[v] >= incumbent;
+    return InduceKeptVertices(neighbour_sets, keep);
+}
+
+// Weighted version: a vertex of a clique heavier than `incumbent` weighs, together with all of its
+// remaining neighbours, more than `incumbent`. Vertices failing that are peeled off one at a time
+// and their weight is taken off the neighbours' sums until no vertex fails.
+inline CliqueReduction ReduceForWeightedClique(const std::vector<std::unordered_set<int>>& neighbour_sets,
+    const std::vector<int>& weights, long long incumbent)
+{
+    int n = neighbour_sets.size();
+    std::vector<long long> bound(n);
+    std::vector<bool> keep(n, true);
+    std::vector<int> peeled;
+    for (int v = 0; v < n; ++v)
+    {
+        bound[v] = weights[v];
+        for (int u : neighbour_sets[v])
+            bound[v] += weights[u];
+        if (bound[v] <= incumbent)
+        {
+            keep[v] = false;
+            peeled.push_back(v);
+        }
+    }
+    while (!peeled.empty())
+    {
+        int v = peeled.back();
+        peeled.pop_back();
+        for (int u : neighbour_sets[v])
+        {
+            bound[u] -= weights[v];
+            if (keep[u] && bound[u] <= incumbent)
+            {
+                keep[u] = false;
+                peeled.push_back(u);
+            }
+        }
+    }
+    return InduceKeptVertices(neighbour_sets, keep);
+}
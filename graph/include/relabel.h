@@ -0,0 +1,115 @@
+#pragma once
+#include <vector>
+#include <unordered_set>
+#include <string>
+#include <algorithm>
+#include "csr_graph.h"
+#include "degeneracy.h"
+
+// Vertex numbering applied after loading a graph. DIMACS ids scatter neighbour accesses; these
+// orders put vertices that are visited together next to each other.
+enum class VertexRelabelling
+{
+    None,
+    Degree,
+    Degeneracy,
+    ReverseCuthillMcKee
+};
+
+inline bool ParseVertexRelabelling(const std::string& name, VertexRelabelling& relabelling)
+{
+    if (name == "none")
+        relabelling = VertexRelabelling::None;
+    else if (name == "degree")
+        relabelling = VertexRelabelling::Degree;
+    else if (name == "degeneracy")
+        relabelling = VertexRelabelling::Degeneracy;
+    else if (name == "rcm")
+        relabelling = VertexRelabelling::ReverseCuthillMcKee;
+    else
+        return false;
+    return true;
+}
+
+// Reverse Cuthill-McKee: breadth-first search from a minimum degree vertex of every component,
+// neighbours visited by increasing degree, then the whole order reversed. Keeps the nonzeros of
+// the adjacency matrix close to the diagonal.
+inline std::vector<int> ReverseCuthillMcKeeOrder(const CsrGraph& graph)
+{
+    int n = graph.Size();
+    std::vector<int> by_degree(n);
+    for (int v = 0; v < n; ++v)
+        by_degree[v] = v;
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](int a, int b) { return graph.Degree(a) < graph.Degree(b); });
+
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<bool> visited(n, false);
+    for (int root : by_degree)
+    {
+        if (visited[root])
+            continue;
+        visited[root] = true;
+        order.push_back(root);
+        for (size_t head = order.size() - 1; head < order.size(); ++head)
+        {
+            int v = order[head];
+            size_t first = order.size();
+            for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+            {
+                int u = graph.targets[e];
+                if (!visited[u])
+                {
+                    visited[u] = true;
+                    order.push_back(u);
+                }
+            }
+            std::stable_sort(order.begin() + first, order.end(), [&](int a, int b) { return graph.Degree(a) < graph.Degree(b); });
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+// order[new id] = old id. Degree puts the largest degrees first, degeneracy follows the
+// smallest-last removal order that the clique solvers branch in.
+inline std::vector<int> ComputeRelabelling(const CsrGraph& graph, VertexRelabelling relabelling)
+{
+    int n = graph.Size();
+    std::vector<int> order(n);
+    for (int v = 0; v < n; ++v)
+        order[v] = v;
+    switch (relabelling)
+    {
+    case VertexRelabelling::None:
+        break;
+    case VertexRelabelling::Degree:
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return graph.Degree(a) > graph.Degree(b); });
+        break;
+    case VertexRelabelling::Degeneracy:
+        order = ComputeCoreDecomposition(graph).order;
+        break;
+    case VertexRelabelling::ReverseCuthillMcKee:
+        order = ReverseCuthillMcKeeOrder(graph);
+        break;
+    }
+    return order;
+}
+
+// Adjacency rebuilt in the new numbering: vertex i of the result is vertex order[i] of the input
+inline std::vector<std::unordered_set<int>> RelabelNeighbourSets(const std::vector<std::unordered_set<int>>& neighbour_sets,
+    const std::vector<int>& order)
+{
+    int n = neighbour_sets.size();
+    std::vector<int> new_id(n);
+    for (int i = 0; i < n; ++i)
+        new_id[order[i]] = i;
+    std::vector<std::unordered_set<int>> result(n);
+    for (int i = 0; i < n; ++i)
+    {
+        result[i].reserve(neighbour_sets[order[i]].size());
+        for (int u : neighbour_sets[order[i]])
+            result[i].insert(new_id[u]);
+    }
+    return result;
+}
@@ -0,0 +1,373 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include "bit_ops.h"
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MODERNOP_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+// Kernels over bitset rows (arrays of 64-bit words) and sorted neighbour arrays. Every kernel
+// has a scalar, an AVX2 and an AVX-512 version; GetBitKernels() picks the widest one the CPU
+// supports on first use. The vector versions are compiled with target attributes, so the
+// projects need no extra compiler flags and still run on CPUs without AVX.
+struct BitKernels
+{
+    const char* name;
+    // target = a & b, target may alias a or b
+    void (*and_rows)(uint64_t* target, const uint64_t* a, const uint64_t* b, int words);
+    // target = a & ~b
+    void (*and_not_rows)(uint64_t* target, const uint64_t* a, const uint64_t* b, int words);
+    int (*popcount_row)(const uint64_t* row, int words);
+    // Index of the lowest set bit, -1 for an empty row
+    int (*first_set_bit)(const uint64_t* row, int words);
+    // popcount(a & b)
+    int (*intersection_count)(const uint64_t* a, const uint64_t* b, int words);
+    // Common elements of two strictly increasing arrays
+    int (*sorted_intersection_count)(const int* a, int a_size, const int* b, int b_size);
+    // Sum of popcount(set & row u) over the set bits u from first_word on, row u at rows + u * words
+    // and read from u's own word: the edges inside `set` for an adjacency matrix whose rows only
+    // point to larger ids. One call per set instead of one per row.
+    long long (*set_edge_count)(const uint64_t* set, const uint64_t* rows, int first_word, int words);
+};
+
+inline void ScalarAndRows(uint64_t* target, const uint64_t* a, const uint64_t* b, int words)
+{
+    for (int w = 0; w < words; ++w)
+        target[w] = a[w] & b[w];
+}
+
+inline void ScalarAndNotRows(uint64_t* target, const uint64_t* a, const uint64_t* b, int words)
+{
+    for (int w = 0; w < words; ++w)
+        target[w] = a[w] & ~b[w];
+}
+
+inline int ScalarPopCountRow(const uint64_t* row, int words)
+{
+    int count = 0;
+    for (int w = 0; w < words; ++w)
+        count += PopCount(row[w]);
+    return count;
+}
+
+inline int ScalarFirstSetBit(const uint64_t* row, int words)
+{
+    for (int w = 0; w < words; ++w)
+    {
+        if (row[w])
+            return w * 64 + CountTrailingZeros(row[w]);
+    }
+    return -1;
+}
+
+inline int ScalarIntersectionCount(const uint64_t* a, const uint64_t* b, int words)
+{
+    return IntersectionCount(a, b, words);
+}
+
+inline int ScalarSortedIntersectionCount(const int* a, int a_size, const int* b, int b_size)
+{
+    int count = 0, i = 0, j = 0;
+    while (i < a_size && j < b_size)
+    {
+        if (a[i] < b[j])
+            ++i;
+        else if (b[j] < a[i])
+            ++j;
+        else
+        {
+            ++count;
+            ++i;
+            ++j;
+        }
+    }
+    return count;
+}
+
+inline long long ScalarSetEdgeCount(const uint64_t* set, const uint64_t* rows, int first_word, int words)
+{
+    long long count = 0;
+    for (int w = first_word; w < words; ++w)
+    {
+        for (uint64_t bits = set[w]; bits; bits &= bits - 1)
+        {
+            const uint64_t* row = rows + size_t(w * 64 + CountTrailingZeros(bits)) * words;
+            count += IntersectionCount(set + w, row + w, words - w);
+        }
+    }
+    return count;
+}
+
+inline const BitKernels& GetScalarKernels()
+{
+    static const BitKernels kernels = { "scalar", ScalarAndRows, ScalarAndNotRows, ScalarPopCountRow,
+        ScalarFirstSetBit, ScalarIntersectionCount, ScalarSortedIntersectionCount, ScalarSetEdgeCount };
+    return kernels;
+}
+
+#ifdef MODERNOP_X86_KERNELS
+
+#define MODERNOP_AVX2 __attribute__((target("avx2,popcnt,bmi")))
+#define MODERNOP_AVX512 __attribute__((target("avx512f,avx512vpopcntdq,avx2,popcnt,bmi")))
+
+// Per-64-bit-lane popcount through a nibble lookup table (Mula), AVX2 has no vector popcount
+MODERNOP_AVX2 inline __m256i Avx2PopCountLanes(__m256i v)
+{
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i low = _mm256_and_si256(v, low_mask);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+    return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+MODERNOP_AVX2 inline int Avx2SumLanes(__m256i lanes)
+{
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+    return int(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1));
+}
+
+MODERNOP_AVX2 inline void Avx2AndRows(uint64_t* target, const uint64_t* a, const uint64_t* b, int words)
+{
+    int w = 0;
+    for (; w + 4 <= words; w += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + w));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + w));
+        _mm256_storeu_si256((__m256i*)(target + w), _mm256_and_si256(x, y));
+    }
+    for (; w < words; ++w)
+        target[w] = a[w] & b[w];
+}
+
+MODERNOP_AVX2 inline void Avx2AndNotRows(uint64_t* target, const uint64_t* a, const uint64_t* b, int words)
+{
+    int w = 0;
+    for (; w + 4 <= words; w += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + w));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + w));
+        _mm256_storeu_si256((__m256i*)(target + w), _mm256_andnot_si256(y, x));
+    }
+    for (; w < words; ++w)
+        target[w] = a[w] & ~b[w];
+}
+
+MODERNOP_AVX2 inline int Avx2PopCountRow(const uint64_t* row, int words)
+{
+    __m256i lanes = _mm256_setzero_si256();
+    int w = 0;
+    for (; w + 4 <= words; w += 4)
+        lanes = _mm256_add_epi64(lanes, Avx2PopCountLanes(_mm256_loadu_si256((const __m256i*)(row + w))));
+    int count = Avx2SumLanes(lanes);
+    for (; w < words; ++w)
+        count += int(_mm_popcnt_u64(row[w]));
+    return count;
+}
+
+MODERNOP_AVX2 inline int Avx2FirstSetBit(const uint64_t* row, int words)
+{
+    int w = 0;
+    for (; w + 4 <= words; w += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(row + w));
+        if (!_mm256_testz_si256(x, x))
+            break;
+    }
+    for (; w < words; ++w)
+    {
+        if (row[w])
+            return w * 64 + int(_tzcnt_u64(row[w]));
+    }
+    return -1;
+}
+
+MODERNOP_AVX2 inline int Avx2IntersectionCount(const uint64_t* a, const uint64_t* b, int words)
+{
+    __m256i lanes = _mm256_setzero_si256();
+    int w = 0;
+    for (; w + 4 <= words; w += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + w));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + w));
+        lanes = _mm256_add_epi64(lanes, Avx2PopCountLanes(_mm256_and_si256(x, y)));
+    }
+    int count = Avx2SumLanes(lanes);
+    for (; w < words; ++w)
+        count += int(_mm_popcnt_u64(a[w] & b[w]));
+    return count;
+}
+
+// Short rows stay on the popcnt tail of Avx2IntersectionCount, inlined here instead of called
+MODERNOP_AVX2 inline long long Avx2SetEdgeCount(const uint64_t* set, const uint64_t* rows, int first_word, int words)
+{
+    long long count = 0;
+    for (int w = first_word; w < words; ++w)
+    {
+        for (uint64_t bits = set[w]; bits; bits &= bits - 1)
+        {
+            const uint64_t* row = rows + size_t(w * 64 + int(_tzcnt_u64(bits))) * words;
+            count += Avx2IntersectionCount(set + w, row + w, words - w);
+        }
+    }
+    return count;
+}
+
+// Block intersection (Lemire, Schlegel): four elements of each array are compared all against
+// all with three rotations, then the block with the smaller last element is advanced.
+MODERNOP_AVX2 inline int Avx2SortedIntersectionCount(const int* a, int a_size, const int* b, int b_size)
+{
+    int count = 0, i = 0, j = 0;
+    while (i + 4 <= a_size && j + 4 <= b_size)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + j));
+        __m128i match = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(x, y), _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(1, 0, 3, 2))),
+                _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(2, 1, 0, 3)))));
+        count += int(_mm_popcnt_u32(_mm_movemask_ps(_mm_castsi128_ps(match))));
+        int a_last = a[i + 3], b_last = b[j + 3];
+        if (a_last <= b_last)
+            i += 4;
+        if (b_last <= a_last)
+            j += 4;
+    }
+    return count + ScalarSortedIntersectionCount(a + i, a_size - i, b + j, b_size - j);
+}
+
+// AVX-512 versions handle the tail with masked loads, so there is no scalar epilogue
+MODERNOP_AVX512 inline __mmask8 Avx512TailMask(int remaining)
+{
+    return remaining >= 8 ? __mmask8(0xff) : __mmask8((1u << remaining) - 1);
+}
+
+// Horizontal sum without _mm512_reduce_add_epi64, which trips -Wuninitialized in GCC 12 headers
+MODERNOP_AVX512 inline int Avx512SumLanes(__m512i lanes)
+{
+    uint64_t sums[8];
+    _mm512_storeu_si512(sums, lanes);
+    return int(sums[0] + sums[1] + sums[2] + sums[3] + sums[4] + sums[5] + sums[6] + sums[7]);
+}
+
+MODERNOP_AVX512 inline void Avx512AndRows(uint64_t* target, const uint64_t* a, const uint64_t* b, int words)
+{
+    for (int w = 0; w < words; w += 8)
+    {
+        __mmask8 mask = Avx512TailMask(words - w);
+        __m512i x = _mm512_maskz_loadu_epi64(mask, a + w);
+        __m512i y = _mm512_maskz_loadu_epi64(mask, b + w);
+        _mm512_mask_storeu_epi64(target + w, mask, _mm512_maskz_and_epi64(mask, x, y));
+    }
+}
+
+MODERNOP_AVX512 inline void Avx512AndNotRows(uint64_t* target, const uint64_t* a, const uint64_t* b, int words)
+{
+    for (int w = 0; w < words; w += 8)
+    {
+        __mmask8 mask = Avx512TailMask(words - w);
+        __m512i x = _mm512_maskz_loadu_epi64(mask, a + w);
+        __m512i y = _mm512_maskz_loadu_epi64(mask, b + w);
+        _mm512_mask_storeu_epi64(target + w, mask, _mm512_maskz_andnot_epi64(mask, y, x));
+    }
+}
+
+MODERNOP_AVX512 inline int Avx512PopCountRow(const uint64_t* row, int words)
+{
+    __m512i lanes = _mm512_setzero_si512();
+    for (int w = 0; w < words; w += 8)
+        lanes = _mm512_add_epi64(lanes, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(Avx512TailMask(words - w), row + w)));
+    return Avx512SumLanes(lanes);
+}
+
+MODERNOP_AVX512 inline int Avx512FirstSetBit(const uint64_t* row, int words)
+{
+    for (int w = 0; w < words; w += 8)
+    {
+        __m512i x = _mm512_maskz_loadu_epi64(Avx512TailMask(words - w), row + w);
+        __mmask8 nonzero = _mm512_test_epi64_mask(x, x);
+        if (nonzero)
+        {
+            int word = w + int(_tzcnt_u32(nonzero));
+            return word * 64 + int(_tzcnt_u64(row[word]));
+        }
+    }
+    return -1;
+}
+
+MODERNOP_AVX512 inline int Avx512IntersectionCount(const uint64_t* a, const uint64_t* b, int words)
+{
+    __m512i lanes = _mm512_setzero_si512();
+    for (int w = 0; w < words; w += 8)
+    {
+        __mmask8 mask = Avx512TailMask(words - w);
+        __m512i x = _mm512_maskz_loadu_epi64(mask, a + w);
+        __m512i y = _mm512_maskz_loadu_epi64(mask, b + w);
+        lanes = _mm512_add_epi64(lanes, _mm512_popcnt_epi64(_mm512_maskz_and_epi64(mask, x, y)));
+    }
+    return Avx512SumLanes(lanes);
+}
+
+// Rows shorter than one vector are cheaper with popcnt than with a masked load
+MODERNOP_AVX512 inline long long Avx512SetEdgeCount(const uint64_t* set, const uint64_t* rows, int first_word, int words)
+{
+    long long count = 0;
+    for (int w = first_word; w < words; ++w)
+    {
+        for (uint64_t bits = set[w]; bits; bits &= bits - 1)
+        {
+            const uint64_t* row = rows + size_t(w * 64 + int(_tzcnt_u64(bits))) * words;
+            if (words - w >= 8)
+                count += Avx512IntersectionCount(set + w, row + w, words - w);
+            else
+            {
+                for (int x = w; x < words; ++x)
+                    count += int(_mm_popcnt_u64(set[x] & row[x]));
+            }
+        }
+    }
+    return count;
+}
+
+inline bool CpuSupportsAvx2()
+{
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt") && __builtin_cpu_supports("bmi");
+}
+
+inline bool CpuSupportsAvx512()
+{
+    return CpuSupportsAvx2() && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+}
+
+inline const BitKernels& GetAvx2Kernels()
+{
+    static const BitKernels kernels = { "avx2", Avx2AndRows, Avx2AndNotRows, Avx2PopCountRow,
+        Avx2FirstSetBit, Avx2IntersectionCount, Avx2SortedIntersectionCount, Avx2SetEdgeCount };
+    return kernels;
+}
+
+// Sorted arrays keep the 128-bit block kernel, wider blocks only add wasted comparisons
+inline const BitKernels& GetAvx512Kernels()
+{
+    static const BitKernels kernels = { "avx512", Avx512AndRows, Avx512AndNotRows, Avx512PopCountRow,
+        Avx512FirstSetBit, Avx512IntersectionCount, Avx2SortedIntersectionCount, Avx512SetEdgeCount };
+    return kernels;
+}
+
+#else
+
+inline bool CpuSupportsAvx2() { return false; }
+inline bool CpuSupportsAvx512() { return false; }
+inline const BitKernels& GetAvx2Kernels() { return GetScalarKernels(); }
+inline const BitKernels& GetAvx512Kernels() { return GetScalarKernels(); }
+
+#endif
+
+inline const BitKernels& GetBitKernels()
+{
+    static const BitKernels& kernels = CpuSupportsAvx512() ? GetAvx512Kernels()
+        : CpuSupportsAvx2() ? GetAvx2Kernels() : GetScalarKernels();
+    return kernels;
+}
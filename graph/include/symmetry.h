@@ -0,0 +1,343 @@
+#pragma once
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
+#include "csr_graph.h"
+
+// Search nodes one automorphism search may use before giving up on the pair it was asked about
+constexpr long long kAutomorphismSearchBudget = 64;
+// Automorphism search nodes for one whole branch and bound, each orbit computation costs one more
+constexpr long long kSymmetryBudget = 20000;
+
+// Colour refinement (1-dimensional Weisfeiler-Leman): cells are split by the multiset of neighbour
+// colours until the partition is equitable. The multiset is summarized by a sum of mixed colour
+// hashes, and new colours are the ranks of (old colour, that sum), so partitions refined from
+// equivalent starts use the same colour names. A collision only leaves a cell coarser than it
+// could be; automorphisms are always verified edge by edge.
+inline void RefineColours(const CsrGraph& graph, std::vector<int>& colour)
+{
+    int n = graph.Size();
+    if (n == 0)
+        return;
+    auto mix = [](uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    };
+    std::vector<int> sorted = colour;
+    std::sort(sorted.begin(), sorted.end());
+    int cells = std::unique(sorted.begin(), sorted.end()) - sorted.begin();
+    std::vector<std::pair<int, uint64_t>> signature(n);
+    std::vector<uint64_t> hashed(n);
+    std::vector<int> order(n);
+    while (true)
+    {
+        for (int v = 0; v < n; ++v)
+            hashed[v] = mix(colour[v]);
+        for (int v = 0; v < n; ++v)
+        {
+            uint64_t sum = 0;
+            for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+                sum += hashed[graph.targets[e]];
+            signature[v] = {colour[v], sum};
+        }
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return signature[a] < signature[b]; });
+        int rank = 0;
+        colour[order[0]] = 0;
+        for (int i = 1; i < n; ++i)
+        {
+            if (signature[order[i]] != signature[order[i - 1]])
+                ++rank;
+            colour[order[i]] = rank;
+        }
+        // Refinement only splits cells, an unchanged count means a stable partition
+        if (rank + 1 == cells)
+            return;
+        cells = rank + 1;
+    }
+}
+
+// Individualization-refinement search for an automorphism that maps the vertices of every colour
+// of `from` onto the vertices of the same colour of `to`. Both partitions are refined; the first
+// non-singleton cell is split by individualizing its first vertex in `from` against every vertex of
+// that cell in `to`. A discrete pair is a candidate permutation, accepted only if it keeps every
+// edge. Returns false when the budget runs out, so a missing automorphism is never assumed.
+class AutomorphismSearch
+{
+public:
+    explicit AutomorphismSearch(const CsrGraph& graph) : graph(graph) {}
+
+    bool Find(std::vector<int> from, std::vector<int> to, std::vector<int>& permutation, long long budget)
+    {
+        nodes = budget;
+        RefineColours(graph, from);
+        RefineColours(graph, to);
+        return Extend(from, to, permutation);
+    }
+
+private:
+    bool Extend(const std::vector<int>& from, const std::vector<int>& to, std::vector<int>& permutation)
+    {
+        if (--nodes < 0)
+            return false;
+        int n = graph.Size();
+        std::vector<int> from_count(n, 0), to_count(n, 0);
+        for (int v = 0; v < n; ++v)
+        {
+            ++from_count[from[v]];
+            ++to_count[to[v]];
+        }
+        if (from_count != to_count)
+            return false;
+        int cell = -1;
+        for (int c = 0; c < n && cell == -1; ++c)
+        {
+            if (from_count[c] > 1)
+                cell = c;
+        }
+        if (cell == -1)
+            return IsAutomorphism(from, to, permutation);
+
+        int x = std::find(from.begin(), from.end(), cell) - from.begin();
+        std::vector<int> from_next = from;
+        from_next[x] = n;
+        RefineColours(graph, from_next);
+        for (int y = 0; y < n; ++y)
+        {
+            if (to[y] != cell)
+                continue;
+            std::vector<int> to_next = to;
+            to_next[y] = n;
+            RefineColours(graph, to_next);
+            if (Extend(from_next, to_next, permutation))
+                return true;
+            if (nodes < 0)
+                return false;
+        }
+        return false;
+    }
+
+    bool IsAutomorphism(const std::vector<int>& from, const std::vector<int>& to, std::vector<int>& permutation)
+    {
+        int n = graph.Size();
+        std::vector<int> by_colour(n);
+        for (int v = 0; v < n; ++v)
+            by_colour[to[v]] = v;
+        permutation.resize(n);
+        for (int v = 0; v < n; ++v)
+            permutation[v] = by_colour[from[v]];
+        for (int v = 0; v < n; ++v)
+        {
+            int image = permutation[v];
+            if (graph.Degree(v) != graph.Degree(image))
+                return false;
+            const int* row = graph.targets.data() + graph.offsets[image];
+            for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+            {
+                if (!std::binary_search(row, row + graph.Degree(image), permutation[graph.targets[e]]))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    const CsrGraph& graph;
+    long long nodes = 0;
+};
+
+// Orbits of the group generated by the automorphisms found for the graph, as cycles: next[v] is
+// the next vertex of v's orbit and next[v] == v for a vertex no automorphism moved. For every pair
+// of vertices in one refined cell but in different orbits so far, an automorphism mapping one onto
+// the other is searched for; each one found merges all of its cycles. `budget` caps the search
+// nodes over all pairs and is decreased by what was used.
+inline std::vector<int> FindOrbits(const CsrGraph& graph, long long& budget, int* generators = nullptr)
+{
+    int n = graph.Size();
+    std::vector<int> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int v) {
+        while (parent[v] != v)
+            v = parent[v] = parent[parent[v]];
+        return v;
+    };
+    std::vector<int> colour(n, 0);
+    RefineColours(graph, colour);
+    AutomorphismSearch search(graph);
+    std::vector<int> permutation;
+    int found = 0;
+    for (int v = 0; v < n && budget > 0; ++v)
+    {
+        for (int w = v + 1; w < n && budget > 0; ++w)
+        {
+            if (colour[w] != colour[v] || find(w) == find(v))
+                continue;
+            std::vector<int> from = colour, to = colour;
+            from[v] = n;
+            to[w] = n;
+            long long limit = std::min(budget, kAutomorphismSearchBudget);
+            bool mapped = search.Find(from, to, permutation, limit);
+            budget -= mapped ? 1 : limit;
+            if (!mapped)
+                continue;
+            ++found;
+            for (int x = 0; x < n; ++x)
+                parent[find(x)] = find(permutation[x]);
+        }
+    }
+    if (generators)
+        *generators = found;
+
+    std::vector<int> next(n), last(n, -1);
+    for (int v = 0; v < n; ++v)
+    {
+        int root = find(v);
+        next[v] = v;
+        if (last[root] != -1)
+        {
+            next[v] = next[last[root]];
+            next[last[root]] = v;
+        }
+        last[root] = v;
+    }
+    return next;
+}
+
+// Orbital branching for a maximum clique search. At a node whose candidate set is P, every
+// automorphism of the subgraph induced by P maps cliques inside P onto cliques of the same size.
+// Once the branch on v has searched all cliques in P containing v, the rest of v's orbit can leave
+// P: the siblings only need cliques avoiding it. Orbits are computed for the root and for nodes
+// below a parent that had symmetry, while the search budget lasts. The subgraphs shrink and the
+// stabilisers of the clique keep acting on them, so on vertex-transitive graphs most levels of the
+// tree keep only a handful of branches.
+class SymmetryBreaking
+{
+public:
+    // max_depth is the largest clique the search can build, a budget of 0 turns the breaking off
+    SymmetryBreaking(const CsrGraph& graph, int max_depth, long long budget)
+        : graph(graph), levels(max_depth + 1), local_index(graph.Size(), -1), budget(budget)
+    {
+    }
+
+    // Called on entering a node that will branch, with the clique depth and its candidate set
+    template <class Set>
+    void Enter(int depth, const Set& candidates)
+    {
+        if (depth >= int(levels.size()))
+            return;
+        Level& level = levels[depth];
+        level.active = false;
+        if ((depth > 0 && !levels[depth - 1].active) || budget <= 0)
+            return;
+
+        level.vertices.clear();
+        Set rest = candidates;
+        for (int v = rest.First(); v != -1; v = rest.First())
+        {
+            rest.Reset(v);
+            local_index[v] = level.vertices.size();
+            level.vertices.push_back(v);
+        }
+        int m = level.vertices.size();
+        CsrGraph induced;
+        induced.offsets.assign(m + 1, 0);
+        for (int i = 0; i < m; ++i)
+        {
+            int v = level.vertices[i];
+            for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+            {
+                if (local_index[graph.targets[e]] != -1)
+                    induced.targets.push_back(local_index[graph.targets[e]]);
+            }
+            induced.offsets[i + 1] = induced.targets.size();
+        }
+        for (int v : level.vertices)
+            local_index[v] = -1;
+        // A graph and its complement have the same automorphisms, refinement is cheaper on the sparser one
+        if (2 * induced.targets.size() > size_t(m) * (m - 1))
+            induced = Complement(induced);
+
+        int generators = 0;
+        --budget;
+        level.next = FindOrbits(induced, budget, &generators);
+        level.active = generators > 0;
+        if (depth == 0)
+            root_orbits = CountOrbits(level.next);
+        if (level.active)
+            ++symmetric_nodes;
+    }
+
+    // After the branch on v at `depth`: drops the other vertices of v's orbit from the candidates
+    template <class Set>
+    void RemoveOrbit(int depth, int v, Set& candidates)
+    {
+        if (depth >= int(levels.size()) || !levels[depth].active)
+            return;
+        const Level& level = levels[depth];
+        int start = std::lower_bound(level.vertices.begin(), level.vertices.end(), v) - level.vertices.begin();
+        for (int i = level.next[start]; i != start; i = level.next[i])
+        {
+            candidates.Reset(level.vertices[i]);
+            ++pruned;
+        }
+    }
+
+    // Orbits of the whole candidate set at the root, 0 if it was not searched
+    int RootOrbits() const { return root_orbits; }
+    long long Pruned() const { return pruned; }
+    long long SymmetricNodes() const { return symmetric_nodes; }
+
+private:
+    static CsrGraph Complement(const CsrGraph& graph)
+    {
+        int m = graph.Size();
+        CsrGraph complement;
+        complement.offsets.assign(m + 1, 0);
+        std::vector<char> adjacent(m, 0);
+        for (int v = 0; v < m; ++v)
+        {
+            for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+                adjacent[graph.targets[e]] = 1;
+            for (int u = 0; u < m; ++u)
+            {
+                if (u != v && !adjacent[u])
+                    complement.targets.push_back(u);
+            }
+            for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+                adjacent[graph.targets[e]] = 0;
+            complement.offsets[v + 1] = complement.targets.size();
+        }
+        return complement;
+    }
+
+    static int CountOrbits(const std::vector<int>& next)
+    {
+        int orbits = 0;
+        for (size_t v = 0; v < next.size(); ++v)
+        {
+            // Each cycle is counted at its smallest vertex
+            int smallest = v;
+            for (int i = next[v]; i != int(v); i = next[i])
+                smallest = std::min(smallest, i);
+            orbits += smallest == int(v);
+        }
+        return orbits;
+    }
+
+    struct Level
+    {
+        bool active = false;
+        std::vector<int> vertices;
+        std::vector<int> next;
+    };
+
+    const CsrGraph& graph;
+    std::vector<Level> levels;
+    std::vector<int> local_index;
+    long long budget;
+    int root_orbits = 0;
+    long long pruned = 0;
+    long long symmetric_nodes = 0;
+};
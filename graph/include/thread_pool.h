@@ -0,0 +1,76 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Fixed set of worker threads running submitted tasks; Wait() blocks until all of them finished
+class ThreadPool
+{
+public:
+    explicit ThreadPool(int threads)
+    {
+        for (int i = 0; i < threads; ++i)
+            workers.emplace_back([this] { WorkerLoop(); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(guard);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    int Size() const { return workers.size(); }
+
+    void Submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(guard);
+            tasks.push(std::move(task));
+            ++pending;
+        }
+        wake.notify_one();
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(guard);
+        done.wait(lock, [this] { return pending == 0; });
+    }
+
+private:
+    void WorkerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(guard);
+                wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+            std::lock_guard<std::mutex> lock(guard);
+            if (--pending == 0)
+                done.notify_all();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex guard;
+    std::condition_variable wake;
+    std::condition_variable done;
+    int pending = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,109 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+
+// Vertex weights for the maximum weight clique problem. An empty vector means every vertex weighs
+// 1, so the unweighted solvers never touch a weight array. Only the weighted modes load weights,
+// see ChooseVertexWeights.
+
+// DIMACS node line "n <vertex> <weight>" (1-based vertex), also accepted without the leading "n"
+// in sidecar files. Returns false for anything else.
+inline bool ParseWeightLine(const std::string& line, int& vertex, int& weight)
+{
+    std::stringstream line_input(line);
+    if (!line.empty() && line[0] == 'n')
+    {
+        char command;
+        line_input >> command;
+    }
+    return bool(line_input >> vertex >> weight);
+}
+
+// Sidecar weight file, one "<vertex> <weight>" line per weighted vertex, "c" lines are comments.
+// Vertices that are not listed keep weight 1. Returns false if the file cannot be opened.
+inline bool ReadVertexWeights(const std::string& filename, int vertices, std::vector<int>& weights)
+{
+    std::ifstream fin(filename);
+    if (!fin)
+        return false;
+    weights.assign(vertices, 1);
+    std::string line;
+    while (std::getline(fin, line))
+    {
+        int vertex, weight;
+        if (line.empty() || line[0] == 'c' || !ParseWeightLine(line, vertex, weight))
+            continue;
+        if (vertex >= 1 && vertex <= vertices)
+            weights[vertex - 1] = weight;
+    }
+    return true;
+}
+
+// Weights of the DIMACS-W benchmark set (Pullan): vertex i (1-based) weighs i mod 200 + 1
+inline std::vector<int> BenchmarkVertexWeights(int vertices)
+{
+    std::vector<int> weights(vertices);
+    for (int v = 0; v < vertices; ++v)
+        weights[v] = (v + 1) % 200 + 1;
+    return weights;
+}
+
+// Weights of a weighted run, the first source that exists wins: the "<filename>.w" sidecar, the
+// "n" lines of the DIMACS file (file_weights, empty if it had none), the DIMACS-W benchmark weights
+inline std::vector<int> ChooseVertexWeights(const std::string& filename, std::vector<int> file_weights, int vertices)
+{
+    std::vector<int> weights;
+    if (ReadVertexWeights(filename + ".w", vertices, weights))
+        return weights;
+    if (!file_weights.empty())
+        return file_weights;
+    return BenchmarkVertexWeights(vertices);
+}
+
+// Weights after a relabelling or reduction: vertex i of the new graph is vertex ids[i] of the old one
+inline std::vector<int> SelectVertexWeights(const std::vector<int>& weights, const std::vector<int>& ids)
+{
+    if (weights.empty())
+        return weights;
+    std::vector<int> result(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+        result[i] = weights[ids[i]];
+    return result;
+}
+
+// Tie-break of the weighted local search moves: keeps the largest gain offered, a uniformly random
+// one of the equal gains (reservoir sampling). Gains below min_gain are never taken.
+class GainChoice
+{
+public:
+    explicit GainChoice(long long min_gain) : best(min_gain) {}
+
+    // Cheap test before the expensive checks of a candidate
+    bool CanTake(long long gain) const { return gain >= best; }
+
+    // True if the candidate becomes the choice, pick(k) draws uniformly from 1..k
+    template <class Pick>
+    bool Offer(long long gain, Pick&& pick)
+    {
+        ties = gain > best || ties == 0 ? 1 : ties + 1;
+        best = gain;
+        return ties == 1 || pick(ties) == 1;
+    }
+
+private:
+    long long best;
+    int ties = 0;
+};
+
+template <class Vertices>
+inline long long CliqueWeight(const std::vector<int>& weights, const Vertices& clique)
+{
+    if (weights.empty())
+        return clique.size();
+    long long weight = 0;
+    for (int v : clique)
+        weight += weights[v];
+    return weight;
+}
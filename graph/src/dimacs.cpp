@@ -0,0 +1,48 @@
+#include "dimacs.h"
+#include <fstream>
+#include <sstream>
+#include "vertex_weights.h"
+
+DimacsGraph ReadDimacsGraph(const std::string& filename)
+{
+    DimacsGraph graph;
+    std::ifstream fin(filename);
+    std::string line;
+    int vertices = 0, edges = 0;
+    while (std::getline(fin, line))
+    {
+        if (line.empty() || line[0] == 'c')
+        {
+            continue;
+        }
+
+        std::stringstream line_input(line);
+        char command;
+        if (line[0] == 'p')
+        {
+            std::string type;
+            line_input >> command >> type >> vertices >> edges;
+            graph.neighbour_sets.resize(vertices);
+        }
+        else if (line[0] == 'n')
+        {
+            int vertex, weight;
+            if (ParseWeightLine(line, vertex, weight) && vertex >= 1 && vertex <= vertices)
+            {
+                graph.vertex_weights.resize(vertices, 1);
+                graph.vertex_weights[vertex - 1] = weight;
+            }
+        }
+        else
+        {
+            int start, finish;
+            // Edges in DIMACS file can be repeated, but it is not a problem for our sets
+            if (line_input >> command >> start >> finish && start >= 1 && start <= vertices && finish >= 1 && finish <= vertices)
+            {
+                graph.neighbour_sets[start - 1].insert(finish - 1);
+                graph.neighbour_sets[finish - 1].insert(start - 1);
+            }
+        }
+    }
+    return graph;
+}
@@ -0,0 +1,37 @@
+#include "instances.h"
+#include <cstdlib>
+#include <sstream>
+#include <fstream>
+
+std::vector<std::string> SelectInstances(const std::vector<std::string>& defaults)
+{
+    const char* list = std::getenv("MODERNOP_INSTANCES");
+    if (!list || !*list)
+        return defaults;
+    std::vector<std::string> files;
+    std::stringstream input(list);
+    std::string file;
+    while (std::getline(input, file, ';'))
+    {
+        if (!file.empty())
+            files.push_back(file);
+    }
+    return files;
+}
+
+unsigned RunSeed(unsigned fallback)
+{
+    const char* seed = std::getenv("MODERNOP_SEED");
+    if (!seed || !*seed)
+        return fallback;
+    return unsigned(std::strtoul(seed, nullptr, 10));
+}
+
+void ReportResult(const std::string& problem, const std::string& instance, long long value)
+{
+    const char* filename = std::getenv("MODERNOP_RESULTS");
+    if (!filename || !*filename)
+        return;
+    std::ofstream fout(filename, std::ios::app);
+    fout << problem << ';' << instance << ';' << value << '\n';
+}
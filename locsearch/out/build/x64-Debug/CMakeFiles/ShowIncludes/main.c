@@ -1,2 +0,0 @@
-#include "foo.h" 
-int main(){}
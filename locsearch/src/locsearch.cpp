@@ -1,334 +1,491 @@
-#include <iostream>
-#include <fstream>
-#include <string>
-#include <vector>
-#include <sstream>
-#include <time.h>
-#include <random>
-#include <unordered_set>
-#include <algorithm>
-using namespace std;
-
-
-class MaxCliqueTabuSearch
-{
-public:
-    static int GetRandom(int a, int b)
-    {
-        static mt19937 generator;
-        uniform_int_distribution<int> uniform(a, b);
-        return uniform(generator);
-    }
-
-    void ReadGraphFile(string filename)
-    {
-        ifstream fin(filename);
-        string line;
-        int vertices = 0, edges = 0;
-        while (getline(fin, line))
-        {
-            if (line[0] == 'c')
-            {
-                continue;
-            }
-
-            stringstream line_input(line);
-            char command;
-            if (line[0] == 'p')
-            {
-                string type;
-                line_input >> command >> type >> vertices >> edges;
-                neighbour_sets.resize(vertices);
-                qco.resize(vertices);
-                index.resize(vertices, -1);
-                non_neighbours.resize(vertices);
-            }
-            else
-            {
-                int start, finish;
-                line_input >> command >> start >> finish;
-                // Edges in DIMACS file can be repeated, but it is not a problem for our sets
-                neighbour_sets[start - 1].insert(finish - 1);
-                neighbour_sets[finish - 1].insert(start - 1);
-            }
-        }
-        for (int i = 0; i < vertices; ++i)
-        {
-            for (int j = 0; j < vertices; ++j)
-            {
-                if (neighbour_sets[i].count(j) == 0 && i != j)
-                    non_neighbours[i].insert(j);
-            }
-        }
-    }
-
-    void RunSearch(int starts, int randomization)
-    {
-        for (int iter = 0; iter < starts; ++iter)
-        {
-            ClearClique();
-            for (size_t i = 0; i < neighbour_sets.size(); ++i)
-            {
-                qco[i] = i;
-                index[i] = i;
-            }
-            RunInitialHeuristic(randomization);
-            c_border = q_border;
-            int swaps = 0;
-            while (swaps < 100)
-            {
-                if (!Move())
-                {
-                    if (!Swap1To1())
-                    {
-                        break;
-                    }
-                    else
-                    {
-                        ++swaps;
-                    }
-                }
-            }
-            if (q_border > best_clique.size())
-            {
-                best_clique.clear();
-                for (int i = 0; i < q_border; ++i)
-                    best_clique.insert(qco[i]);
-            }
-        }
-    }
-
-    const unordered_set<int>& GetClique()
-    {
-        return best_clique;
-    }
-
-    bool Check()
-    {
-        for (int i : best_clique)
-        {
-            for (int j : best_clique)
-            {
-                if (i != j && neighbour_sets[i].count(j) == 0)
-                {
-                    cout << "Returned subgraph is not clique\n";
-                    return false;
-                }
-            }
-        }
-        return true;
-    }
-
-    void ClearClique()
-    {
-        q_border = 0;
-        c_border = 0;
-    }
-
-
-    void GetDensity() {
-        int num_edges = 0;
-        for (int i = 0; i < neighbour_sets.size(); i++) {
-            num_edges += neighbour_sets[i].size();
-        }
-        density = static_cast<double>(num_edges) / (neighbour_sets.size() * (neighbour_sets.size() - 1));
-    }
-
-    void GetModularity() {
-        double Q = 0.0;
-        for (int i = 0; i < qco.size(); i++) {
-            int c_i = index[qco[i]];
-            for (int j = i + 1; j < qco.size(); j++) {
-                int c_j = index[qco[j]];
-                if (c_i == c_j) {
-                    Q += 1.0;
-                }
-            }
-        }
-        modularity = Q / (qco.size() * (qco.size() - 1) / 2.0);
-    }
-
-    void GetDegreeDistribution() {
-        vector<int> degree_counts(neighbour_sets.size(), 0);
-        for (int i = 0; i < neighbour_sets.size(); i++) {
-            degree_counts[neighbour_sets[i].size()]++;
-        }
-        degdistr = degree_counts;
-    }
-
-private:
-    vector<unordered_set<int>> neighbour_sets;
-    vector<unordered_set<int>> non_neighbours;
-    unordered_set<int> best_clique;
-    vector<int> qco;
-    vector<int> index;
-    int q_border = 0;
-    int c_border = 0;
-
-    // extra params:
-    double density;
-    double modularity;
-    vector<int> degdistr;
-
-    int ComputeTightness(int vertex)
-    {
-        int tightness = 0;
-        for (int i = 0; i < q_border; ++i)
-        {
-            if (non_neighbours[qco[i]].count(vertex))
-                ++tightness;
-        }
-        return tightness;
-    }
-
-    void SwapVertices(int vertex, int border)
-    {
-        int vertex_at_border = qco[border];
-        swap(qco[index[vertex]], qco[border]);
-        swap(index[vertex], index[vertex_at_border]);
-    }
-
-    void InsertToClique(int i)
-    {
-        for (int j : non_neighbours[i])
-        {
-            if (ComputeTightness(j) == 0)
-            {
-                --c_border;
-                SwapVertices(j, c_border);
-            }
-        }
-        SwapVertices(i, q_border);
-        ++q_border;
-    }
-
-    void RemoveFromClique(int k)
-    {
-        for (int j : non_neighbours[k])
-        {
-            if (ComputeTightness(j) == 1)
-            {
-                SwapVertices(j, c_border);
-                c_border++;
-            }
-        }
-        --q_border;
-        SwapVertices(k, q_border);
-    }
-
-    bool Swap1To1()
-    {
-        for (int counter = 0; counter < q_border; ++counter)
-        {
-            int vertex = qco[counter];
-            for (int i : non_neighbours[vertex])
-            {
-                if (ComputeTightness(i) == 1)
-                {
-                    RemoveFromClique(vertex);
-                    InsertToClique(i);
-                    return true;
-                }
-            }
-        }
-        return false;
-    }
-
-    bool Move()
-    {
-        if (c_border == q_border)
-            return false;
-        int vertex = qco[q_border];
-        InsertToClique(vertex);
-        return true;
-    }
-
-    void RunInitialHeuristic(int randomization)
-    {
-        static mt19937 generator;
-        vector<int> candidates(neighbour_sets.size());
-        for (size_t i = 0; i < neighbour_sets.size(); ++i)
-        {
-            candidates[i] = i;
-        }
-        shuffle(candidates.begin(), candidates.end(), generator);
-        while (!candidates.empty())
-        {
-            int last = candidates.size() - 1;
-            int rnd = GetRandom(0, min(randomization - 1, last));
-            int vertex = candidates[rnd];
-            SwapVertices(vertex, q_border);
-            ++q_border;
-            for (int c = 0; c < candidates.size(); ++c)
-            {
-                int candidate = candidates[c];
-                if (neighbour_sets[vertex].count(candidate) == 0)
-                {
-                    // Move the candidate to the end and pop it
-                    swap(candidates[c], candidates[candidates.size() - 1]);
-                    candidates.pop_back();
-                    --c;
-                }
-            }
-            shuffle(candidates.begin(), candidates.end(), generator);
-        }
-    }
-};
-
-string GetProjectFolder() {
-    string path = __FILE__;
-    size_t found = path.find_last_of("\\/");
-
-    // get current project folder
-    string folderPath = path.substr(0, found);
-    return folderPath;
-}
-
-int main()
-{
-    string projFolder = GetProjectFolder();
-    string cliqueF = projFolder + "\\..\\cliques\\";
-
-    int iterations;
-    cout << "Number of iterations: ";
-    cin >> iterations;
-    int randomization;
-    cout << "Randomization: ";
-    cin >> randomization;
-    vector<string> files = {
-        cliqueF + "brock200_1.clq", cliqueF + "brock200_2.clq", cliqueF + "brock200_3.clq", cliqueF + "brock200_4.clq",
-        cliqueF + "brock400_1.clq", cliqueF + "brock400_2.clq", cliqueF + "brock400_3.clq", cliqueF + "brock400_4.clq",
-        cliqueF + "C125.9.clq",
-        cliqueF + "gen200_p0.9_44.clq", cliqueF + "gen200_p0.9_55.clq",
-        cliqueF + "hamming8-4.clq",
-        cliqueF + "johnson16-2-4.clq", cliqueF + "johnson8-2-4.clq",
-        cliqueF + "keller4.clq",
-        cliqueF + "MANN_a27.clq", cliqueF + "MANN_a9.clq",
-        cliqueF + "p_hat1000-1.clq", cliqueF + "p_hat1000-2.clq", cliqueF + "p_hat1500-1.clq", cliqueF + "p_hat300-3.clq", cliqueF + "p_hat500-3.clq",
-        cliqueF + "san1000.clq", cliqueF + "sanr200_0.9.clq", cliqueF + "sanr400_0.7.clq"
-    };
-    ofstream fout("clique_tabu.csv");
-    fout << "File; Clique; Time (sec)\n";
-    for (string file : files)
-    {
-        MaxCliqueTabuSearch problem;
-        problem.ReadGraphFile(file);
-        clock_t start = clock();
-
-        problem.GetDegreeDistribution();
-        problem.GetDensity();
-        problem.GetModularity();
-
-
-        problem.RunSearch(iterations, randomization);
-        if (!problem.Check())
-        {
-            cout << "*** WARNING: incorrect clique ***\n";
-            fout << "*** WARNING: incorrect clique ***\n";
-        }
-        fout << file << "; " << problem.GetClique().size() << "; " << double(clock() - start) / CLOCKS_PER_SEC << '\n';
-        cout << file << ", result - " << problem.GetClique().size() << ", time - " << double(clock() - start) / CLOCKS_PER_SEC << '\n';
-    }
-    fout.close();
-    return 0;
-}
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <time.h>
+#include <random>
+#include <unordered_set>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include "csr_graph.h"
+#include "dimacs.h"
+#include "instances.h"
+#include "degeneracy.h"
+#include "reduction.h"
+#include "relabel.h"
+#include "kclique_count.h"
+#include "vertex_weights.h"
+using namespace std;
+
+
+class MaxCliqueTabuSearch
+{
+public:
+    static int GetRandom(int a, int b)
+    {
+        static mt19937 generator(RunSeed());
+        uniform_int_distribution<int> uniform(a, b);
+        return uniform(generator);
+    }
+
+    void ReadGraphFile(string filename, bool weighted)
+    {
+        DimacsGraph graph = ReadDimacsGraph(filename);
+        neighbour_sets = move(graph.neighbour_sets);
+        int vertices = neighbour_sets.size();
+        // Without weighted the search stays maximum cardinality, "n" lines of the file included
+        if (weighted)
+            vertex_weights = ChooseVertexWeights(filename, move(graph.vertex_weights), vertices);
+        original_ids.resize(vertices);
+        iota(original_ids.begin(), original_ids.end(), 0);
+        weights = vertex_weights;
+        reduction_stats.vertices_before = reduction_stats.vertices_after = vertices;
+        for (const unordered_set<int>& neighbours : neighbour_sets)
+            reduction_stats.edges_before += neighbours.size();
+        reduction_stats.edges_before /= 2;
+        reduction_stats.edges_after = reduction_stats.edges_before;
+        BuildSearchState();
+    }
+
+    // Vertex weights in file ids (see vertex_weights.h), from then on the search maximises the
+    // clique weight. Can be called after relabelling or reduction.
+    void SetVertexWeights(vector<int> file_weights)
+    {
+        vertex_weights = move(file_weights);
+        weights = SelectVertexWeights(vertex_weights, original_ids);
+        best_weight = CliqueWeight(vertex_weights, best_clique);
+    }
+
+    bool IsWeighted()
+    {
+        return !vertex_weights.empty();
+    }
+
+    // Continues on the subgraph of the vertices that can be in a clique larger than the best one.
+    // The best clique is kept in original ids and Check() runs against the original graph.
+    void ReduceGraph()
+    {
+        CliqueReduction reduction = IsWeighted() ? ReduceForWeightedClique(neighbour_sets, weights, best_weight)
+            : ReduceForClique(neighbour_sets, best_clique.size());
+        reduction_stats.vertices_after = reduction.stats.vertices_after;
+        reduction_stats.edges_after = reduction.stats.edges_after;
+        ReplaceGraph(move(reduction.neighbour_sets), reduction.original_ids);
+    }
+
+    // Renumbers the vertices for locality (see relabel.h), the best clique stays in original ids
+    void RelabelVertices(VertexRelabelling relabelling)
+    {
+        if (relabelling == VertexRelabelling::None)
+            return;
+        vector<int> order = ComputeRelabelling(BuildCsrGraph(neighbour_sets), relabelling);
+        ReplaceGraph(RelabelNeighbourSets(neighbour_sets, order), order);
+    }
+
+    const ReductionStats& GetReductionStats()
+    {
+        return reduction_stats;
+    }
+
+    void RunSearch(int starts, int randomization)
+    {
+        for (int iter = 0; iter < starts; ++iter)
+        {
+            ClearClique();
+            for (size_t i = 0; i < neighbour_sets.size(); ++i)
+            {
+                qco[i] = i;
+                index[i] = i;
+            }
+            RunInitialHeuristic(randomization);
+            c_border = q_border;
+            int swaps = 0;
+            while (swaps < 100)
+            {
+                if (!Move())
+                {
+                    if (!Swap1To1())
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        ++swaps;
+                    }
+                }
+            }
+            long long weight = CliqueWeight(weights, vector<int>(qco.begin(), qco.begin() + q_border));
+            if (weight > best_weight)
+            {
+                best_clique.clear();
+                for (int i = 0; i < q_border; ++i)
+                    best_clique.insert(original_ids[qco[i]]);
+                best_weight = weight;
+            }
+            // No clique is larger than degeneracy + 1, the rest of the starts cannot improve
+            if (!IsWeighted() && int(best_clique.size()) >= degeneracy + 1)
+                break;
+        }
+    }
+
+    const unordered_set<int>& GetClique()
+    {
+        return best_clique;
+    }
+
+    // Clique weight, the size for an unweighted graph
+    long long GetCliqueWeight()
+    {
+        return best_weight;
+    }
+
+    bool Check()
+    {
+        const vector<unordered_set<int>>& graph = original_neighbour_sets.empty() ? neighbour_sets : original_neighbour_sets;
+        for (int i : best_clique)
+        {
+            for (int j : best_clique)
+            {
+                if (i != j && graph[i].count(j) == 0)
+                {
+                    cout << "Returned subgraph is not clique\n";
+                    return false;
+                }
+            }
+        }
+        if (CliqueWeight(vertex_weights, best_clique) != best_weight)
+        {
+            cout << "Clique weight does not match its vertices\n";
+            return false;
+        }
+        return true;
+    }
+
+    void ClearClique()
+    {
+        q_border = 0;
+        c_border = 0;
+    }
+
+
+    void GetDensity() {
+        int num_edges = 0;
+        for (int i = 0; i < neighbour_sets.size(); i++) {
+            num_edges += neighbour_sets[i].size();
+        }
+        density = static_cast<double>(num_edges) / (neighbour_sets.size() * (neighbour_sets.size() - 1));
+    }
+
+    void GetModularity() {
+        double Q = 0.0;
+        for (int i = 0; i < qco.size(); i++) {
+            int c_i = index[qco[i]];
+            for (int j = i + 1; j < qco.size(); j++) {
+                int c_j = index[qco[j]];
+                if (c_i == c_j) {
+                    Q += 1.0;
+                }
+            }
+        }
+        modularity = Q / (qco.size() * (qco.size() - 1) / 2.0);
+    }
+
+    void GetDegreeDistribution() {
+        vector<int> degree_counts(neighbour_sets.size(), 0);
+        for (int i = 0; i < neighbour_sets.size(); i++) {
+            degree_counts[neighbour_sets[i].size()]++;
+        }
+        degdistr = degree_counts;
+    }
+
+    // Number of s-cliques for every s up to max_k (triangles are clique_counts.counts[3]), counted in
+    // parallel over a degeneracy-oriented DAG, see kclique_count.h
+    const CliqueCounts& GetCliqueCounts(int max_k, int threads, bool per_vertex = false)
+    {
+        clique_counts = CountCliques(BuildCsrGraph(neighbour_sets), max_k, threads, per_vertex);
+        return clique_counts;
+    }
+
+private:
+    vector<unordered_set<int>> neighbour_sets;
+    vector<unordered_set<int>> non_neighbours;
+    unordered_set<int> best_clique;
+    long long best_weight = 0;
+    // Empty for an unweighted graph; vertex_weights is in file ids, weights in current ids
+    vector<int> vertex_weights;
+    vector<int> weights;
+    vector<int> qco;
+    vector<int> index;
+    int q_border = 0;
+    int c_border = 0;
+    int degeneracy = 0;
+    vector<unordered_set<int>> original_neighbour_sets;
+    vector<int> original_ids;
+    ReductionStats reduction_stats;
+
+    // extra params:
+    double density;
+    double modularity;
+    vector<int> degdistr;
+    CliqueCounts clique_counts;
+
+    // Switches to a graph whose vertex i is vertex ids[i] of the current one
+    void ReplaceGraph(vector<unordered_set<int>> graph, const vector<int>& ids)
+    {
+        vector<int> composed(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i)
+            composed[i] = original_ids[ids[i]];
+        if (original_neighbour_sets.empty())
+            original_neighbour_sets = move(neighbour_sets);
+        neighbour_sets = move(graph);
+        original_ids = move(composed);
+        weights = SelectVertexWeights(weights, ids);
+        BuildSearchState();
+    }
+
+    // Search arrays and the degeneracy bound for the current (possibly reduced) graph
+    void BuildSearchState()
+    {
+        int vertices = neighbour_sets.size();
+        qco.assign(vertices, 0);
+        index.assign(vertices, -1);
+        non_neighbours.assign(vertices, unordered_set<int>());
+        degeneracy = ComputeCoreDecomposition(BuildCsrGraph(neighbour_sets)).degeneracy;
+        for (int i = 0; i < vertices; ++i)
+        {
+            for (int j = 0; j < vertices; ++j)
+            {
+                if (neighbour_sets[i].count(j) == 0 && i != j)
+                    non_neighbours[i].insert(j);
+            }
+        }
+    }
+
+    int ComputeTightness(int vertex)
+    {
+        int tightness = 0;
+        for (int i = 0; i < q_border; ++i)
+        {
+            if (non_neighbours[qco[i]].count(vertex))
+                ++tightness;
+        }
+        return tightness;
+    }
+
+    void SwapVertices(int vertex, int border)
+    {
+        int vertex_at_border = qco[border];
+        swap(qco[index[vertex]], qco[border]);
+        swap(index[vertex], index[vertex_at_border]);
+    }
+
+    void InsertToClique(int i)
+    {
+        for (int j : non_neighbours[i])
+        {
+            if (ComputeTightness(j) == 0)
+            {
+                --c_border;
+                SwapVertices(j, c_border);
+            }
+        }
+        SwapVertices(i, q_border);
+        ++q_border;
+    }
+
+    void RemoveFromClique(int k)
+    {
+        for (int j : non_neighbours[k])
+        {
+            if (ComputeTightness(j) == 1)
+            {
+                SwapVertices(j, c_border);
+                c_border++;
+            }
+        }
+        --q_border;
+        SwapVertices(k, q_border);
+    }
+
+    // Weighted swap (FastWClq-style score): the 1-tight vertex and the clique vertex it replaces with
+    // the largest weight gain, ties broken at random (GainChoice); swaps that lose weight are not made
+    bool WeightedSwap1To1()
+    {
+        int best_out = -1, best_in = -1;
+        GainChoice choice(0);
+        for (int counter = 0; counter < q_border; ++counter)
+        {
+            int vertex = qco[counter];
+            for (int i : non_neighbours[vertex])
+            {
+                long long gain = weights[i] - weights[vertex];
+                if (!choice.CanTake(gain) || ComputeTightness(i) != 1)
+                    continue;
+                if (choice.Offer(gain, [](int ties) { return GetRandom(1, ties); }))
+                {
+                    best_out = vertex;
+                    best_in = i;
+                }
+            }
+        }
+        if (best_out == -1)
+            return false;
+        RemoveFromClique(best_out);
+        InsertToClique(best_in);
+        return true;
+    }
+
+    bool Swap1To1()
+    {
+        if (IsWeighted())
+            return WeightedSwap1To1();
+        for (int counter = 0; counter < q_border; ++counter)
+        {
+            int vertex = qco[counter];
+            for (int i : non_neighbours[vertex])
+            {
+                if (ComputeTightness(i) == 1)
+                {
+                    RemoveFromClique(vertex);
+                    InsertToClique(i);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool Move()
+    {
+        if (c_border == q_border)
+            return false;
+        int vertex = qco[q_border];
+        // Every free vertex is adjacent to the whole clique, the heaviest one is the best add
+        if (IsWeighted())
+        {
+            for (int i = q_border + 1; i < c_border; ++i)
+            {
+                if (weights[qco[i]] > weights[vertex])
+                    vertex = qco[i];
+            }
+        }
+        InsertToClique(vertex);
+        return true;
+    }
+
+    void RunInitialHeuristic(int randomization)
+    {
+        static mt19937 generator(RunSeed());
+        vector<int> candidates(neighbour_sets.size());
+        for (size_t i = 0; i < neighbour_sets.size(); ++i)
+        {
+            candidates[i] = i;
+        }
+        shuffle(candidates.begin(), candidates.end(), generator);
+        while (!candidates.empty())
+        {
+            // A weighted search picks among the `randomization` heaviest candidates
+            if (IsWeighted())
+                stable_sort(candidates.begin(), candidates.end(), [&](int a, int b) { return weights[a] > weights[b]; });
+            int last = candidates.size() - 1;
+            int rnd = GetRandom(0, min(randomization - 1, last));
+            int vertex = candidates[rnd];
+            SwapVertices(vertex, q_border);
+            ++q_border;
+            for (int c = 0; c < candidates.size(); ++c)
+            {
+                int candidate = candidates[c];
+                if (neighbour_sets[vertex].count(candidate) == 0)
+                {
+                    // Move the candidate to the end and pop it
+                    swap(candidates[c], candidates[candidates.size() - 1]);
+                    candidates.pop_back();
+                    --c;
+                }
+            }
+            shuffle(candidates.begin(), candidates.end(), generator);
+        }
+    }
+};
+
+string GetProjectFolder() {
+    string path = __FILE__;
+    size_t found = path.find_last_of("\\/");
+
+    // get current project folder
+    string folderPath = path.substr(0, found);
+    return folderPath;
+}
+
+int main(int argc, char* argv[])
+{
+    VertexRelabelling relabelling = VertexRelabelling::None;
+    bool weighted = argc > 2 && string(argv[2]) == "weighted";
+    // Starts of the tabu search and randomization of the initial heuristic
+    int iterations = argc > 3 ? atoi(argv[3]) : 200;
+    int randomization = argc > 4 ? atoi(argv[4]) : 10;
+    if ((argc > 1 && !ParseVertexRelabelling(argv[1], relabelling)) || (argc > 2 && !weighted && string(argv[2]) != "plain") ||
+        iterations < 1 || randomization < 1)
+    {
+        cout << "Usage: locsearch [none|degree|degeneracy|rcm] [plain|weighted] [iterations] [randomization]\n";
+        return 1;
+    }
+    string projFolder = GetProjectFolder();
+    string cliqueF = projFolder + "/../cliques/";
+
+    vector<string> files = {
+        cliqueF + "brock200_1.clq", cliqueF + "brock200_2.clq", cliqueF + "brock200_3.clq", cliqueF + "brock200_4.clq",
+        cliqueF + "brock400_1.clq", cliqueF + "brock400_2.clq", cliqueF + "brock400_3.clq", cliqueF + "brock400_4.clq",
+        cliqueF + "C125.9.clq", cliqueF + "DSJC1000_5.clq",
+        cliqueF + "gen200_p0.9_44.clq", cliqueF + "gen200_p0.9_55.clq",
+        cliqueF + "hamming8-4.clq",
+        cliqueF + "johnson16-2-4.clq", cliqueF + "johnson8-2-4.clq",
+        cliqueF + "keller4.clq",
+        cliqueF + "MANN_a27.clq", cliqueF + "MANN_a9.clq",
+        cliqueF + "p_hat1000-1.clq", cliqueF + "p_hat1000-2.clq", cliqueF + "p_hat1500-1.clq", cliqueF + "p_hat300-3.clq", cliqueF + "p_hat500-3.clq",
+        cliqueF + "san1000.clq", cliqueF + "sanr200_0.9.clq", cliqueF + "sanr400_0.7.clq"
+    };
+    files = SelectInstances(files);
+    ofstream fout(weighted ? "clique_tabu_weighted.csv" : "clique_tabu.csv");
+    int threads = max(1u, thread::hardware_concurrency());
+    fout << "File; Clique; Weight; Time (sec); Vertices; Reduced vertices; Edges; Reduced edges; Triangles; 4-cliques; 5-cliques; Counting time (sec)\n";
+    for (string file : files)
+    {
+        MaxCliqueTabuSearch problem;
+        problem.ReadGraphFile(file, weighted);
+
+        // Graph statistics are not part of the search time, the clique counting runs on all threads
+        // and gets its own wall-clock column
+        problem.GetDegreeDistribution();
+        problem.GetDensity();
+        problem.GetModularity();
+        auto counting_start = chrono::steady_clock::now();
+        const CliqueCounts& counts = problem.GetCliqueCounts(5, threads);
+        double counting_time = chrono::duration<double>(chrono::steady_clock::now() - counting_start).count();
+
+        clock_t start = clock();
+        problem.RelabelVertices(relabelling);
+
+        // One start gives the incumbent for the k-core reduction
+        problem.RunSearch(1, randomization);
+        problem.ReduceGraph();
+        problem.RunSearch(iterations, randomization);
+        if (!problem.Check())
+        {
+            cout << "*** WARNING: incorrect clique ***\n";
+            fout << "*** WARNING: incorrect clique ***\n";
+        }
+        ReportResult(weighted ? "weighted_clique" : "clique", file, weighted ? problem.GetCliqueWeight() : problem.GetClique().size());
+        const ReductionStats& reduction = problem.GetReductionStats();
+        fout << file << "; " << problem.GetClique().size() << "; " << problem.GetCliqueWeight() << "; " << double(clock() - start) / CLOCKS_PER_SEC << "; "
+            << reduction.vertices_before << "; " << reduction.vertices_after << "; " << reduction.edges_before << "; " << reduction.edges_after << "; "
+            << counts.counts[3] << "; " << counts.counts[4] << "; " << counts.counts[5] << "; " << counting_time << '\n';
+        cout << file << ", result - " << problem.GetClique().size() << ", weight - " << problem.GetCliqueWeight() << ", time - " << double(clock() - start) / CLOCKS_PER_SEC
+            << ", reduced to " << reduction.vertices_after << "/" << reduction.vertices_before << " vertices\n";
+    }
+    fout.close();
+    return 0;
+}
@@ -1,227 +1,337 @@
-#include <iostream>
-#include <fstream>
-#include <string>
-#include <vector>
-#include <sstream>
-#include <time.h>
-#include <random>
-#include <unordered_set>
-#include <algorithm>
-using namespace std;
-
-
-class MaxCliqueProblem
-{
-public:
-    static int GetRandom(int a, int b)
-    {
-        static mt19937 generator;
-        uniform_int_distribution<int> uniform(a, b);
-        return uniform(generator);
-    }
-
-    void ReadGraphFile(string filename)
-    {
-        ifstream fin(filename);
-        string line;
-        int vertices = 0, edges = 0;
-        while (getline(fin, line))
-        {
-            if (line[0] == 'c')
-            {
-                continue;
-            }
-
-            stringstream line_input(line);
-            char command;
-            if (line[0] == 'p')
-            {
-                string type;
-                line_input >> command >> type >> vertices >> edges;
-                neighbour_sets.resize(vertices);
-            }
-            else
-            {
-                int start, finish;
-                line_input >> command >> start >> finish;
-                // Edges in DIMACS file can be repeated, but it is not a problem for our sets
-                neighbour_sets[start - 1].insert(finish - 1);
-                neighbour_sets[finish - 1].insert(start - 1);
-            }
-        }
-    }
-
-    void FindClique(int randomization, int iterations)
-    {
-        static mt19937 generator;
-        for (int iteration = 0; iteration < iterations; ++iteration)
-        {
-            vector<int> clique;
-            vector<int> candidates(neighbour_sets.size());
-            for (int i = 0; i < neighbour_sets.size(); ++i)
-            {
-                candidates[i] = i;
-            }
-            shuffle(candidates.begin(), candidates.end(), generator);
-            while (!candidates.empty())
-            {
-                int last = candidates.size() - 1;
-                int rnd = GetRandom(0, min(randomization - 1, last));
-                int vertex = candidates[rnd];
-                clique.push_back(vertex);
-                for (int c = 0; c < candidates.size(); ++c)
-                {
-                    int candidate = candidates[c];
-                    if (neighbour_sets[vertex].count(candidate) == 0)
-                    {
-                        // Move the candidate to the end and pop it
-                        swap(candidates[c], candidates[last]);
-                        candidates.pop_back();
-                        --c;
-                    }
-                }
-                shuffle(candidates.begin(), candidates.end(), generator);
-            }
-            if (clique.size() > best_clique.size())
-            {
-                best_clique = clique;
-            }
-        }
-    }
-
-    void BasicGreedyRandomizedAlgorithm(int randomization, int iterations)
-    {
-        vector<int> best_clique;
-        static mt19937 generator;
-
-        // Repeat the algorithm for the given number of iterations
-        for (int iteration = 0; iteration < iterations; ++iteration)
-        {
-            vector<int> clique;
-            vector<int> candidates(neighbour_sets.size());
-
-            // Initialize the candidates vector
-            for (int i = 0; i < neighbour_sets.size(); ++i)
-            {
-                candidates[i] = i;
-            }
-
-            // Shuffle the candidates vector randomly
-            shuffle(candidates.begin(), candidates.end(), generator);
-
-            // Construct the clique
-            while (!candidates.empty())
-            {
-                int last = candidates.size() - 1;
-                int rnd = GetRandom(0, min(randomization - 1, last));
-                int vertex = candidates[rnd];
-                clique.push_back(vertex);
-
-                // Remove vertices that are not adjacent to the last added vertex
-                for (int c = 0; c < candidates.size(); ++c)
-                {
-                    int candidate = candidates[c];
-                    if (neighbour_sets[vertex].count(candidate) == 0)
-                    {
-                        swap(candidates[c], candidates[last]);
-                        candidates.pop_back();
-                        --c;
-                    }
-                }
-
-                // Shuffle the candidates vector randomly again
-                shuffle(candidates.begin(), candidates.end(), generator);
-            }
-
-            // Update the best clique found so far
-            if (clique.size() > best_clique.size())
-            {
-                best_clique = clique;
-            }
-        }
-
-    }
-
-    const vector<int>& GetClique()
-    {
-        return best_clique;
-    }
-
-    bool Check()
-    {
-        if (unique(best_clique.begin(), best_clique.end()) != best_clique.end())
-        {
-            cout << "Duplicated vertices in the clique\n";
-            return false;
-        }
-        for (int i : best_clique)
-        {
-            for (int j : best_clique)
-            {
-                if (i != j && neighbour_sets[i].count(j) == 0)
-                {
-                    cout << "Returned subgraph is not a clique\n";
-                    return false;
-                }
-            }
-        }
-        return true;
-    }
-
-private:
-    vector<unordered_set<int>> neighbour_sets;
-    vector<int> best_clique;
-};
-
-string GetProjectFolder() {
-    string path = __FILE__;
-    size_t found = path.find_last_of("\\/");
-
-    // get current project folder
-    string folderPath = path.substr(0, found);
-    return folderPath;
-}
-
-int main()
-{
-    string projFolder = GetProjectFolder();
-    string cliqueF = projFolder + "\\..\\cliques\\";
-
-    int iterations = 10000;
-    //cout << "Number of iterations: ";
-    //cin >> iterations;
-    int randomization = 10;
-    //cout << "Randomization: ";
-    //cin >> randomization;
-    vector<string> files = { 
-        cliqueF + "brock200_1.clq", cliqueF + "brock200_2.clq", cliqueF + "brock200_3.clq", cliqueF + "brock200_4.clq",
-        cliqueF + "brock400_1.clq", cliqueF + "brock400_2.clq", cliqueF + "brock400_3.clq", cliqueF + "brock400_4.clq",
-        cliqueF + "C125.9.clq", 
-        cliqueF + "gen200_p0.9_44.clq", cliqueF + "gen200_p0.9_55.clq",
-        cliqueF + "hamming8-4.clq",
-        cliqueF + "johnson16-2-4.clq", cliqueF + "johnson8-2-4.clq",
-        cliqueF + "keller4.clq",
-        cliqueF + "MANN_a27.clq", cliqueF + "MANN_a9.clq",
-        cliqueF + "p_hat1000-1.clq", cliqueF + "p_hat1000-2.clq", cliqueF + "p_hat1500-1.clq", cliqueF + "p_hat300-3.clq", cliqueF + "p_hat500-3.clq",
-        cliqueF + "san1000.clq", cliqueF + "sanr200_0.9.clq", cliqueF + "sanr400_0.7.clq"
-         };
-    ofstream fout("clique.csv");
-    fout << "File; Clique; Time (sec)\n";
-    for (string file : files)
-    {
-        MaxCliqueProblem problem;
-        problem.ReadGraphFile(file);
-        clock_t start = clock();
-        problem.BasicGreedyRandomizedAlgorithm(randomization, iterations);
-        //problem.FindClique(randomization, iterations);
-        if (!problem.Check())
-        {
-            cout << "*** WARNING: incorrect clique ***\n";
-            fout << "*** WARNING: incorrect clique ***\n";
-        }
-        fout << file << "; " << problem.GetClique().size() << "; " << double(clock() - start) / CLOCKS_PER_SEC << '\n';
-        cout << file << ", result - " << problem.GetClique().size() << ", time - " << double(clock() - start) / CLOCKS_PER_SEC << '\n';
-    }
-    fout.close();
-    return 0;
-}
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <time.h>
+#include <random>
+#include <unordered_set>
+#include <algorithm>
+#include <numeric>
+#include "csr_graph.h"
+#include "dimacs.h"
+#include "instances.h"
+#include "degeneracy.h"
+#include "reduction.h"
+#include "relabel.h"
+#include "vertex_weights.h"
+using namespace std;
+
+
+class MaxCliqueProblem
+{
+public:
+    static int GetRandom(int a, int b)
+    {
+        static mt19937 generator(RunSeed());
+        uniform_int_distribution<int> uniform(a, b);
+        return uniform(generator);
+    }
+
+    void ReadGraphFile(string filename, bool weighted)
+    {
+        DimacsGraph graph = ReadDimacsGraph(filename);
+        neighbour_sets = move(graph.neighbour_sets);
+        int vertices = neighbour_sets.size();
+        // Without weighted the search stays maximum cardinality, "n" lines of the file included
+        if (weighted)
+            vertex_weights = ChooseVertexWeights(filename, move(graph.vertex_weights), vertices);
+        cores = ComputeCoreDecomposition(BuildCsrGraph(neighbour_sets));
+        original_ids.resize(vertices);
+        iota(original_ids.begin(), original_ids.end(), 0);
+        weights = vertex_weights;
+        reduction_stats.vertices_before = reduction_stats.vertices_after = vertices;
+        for (const unordered_set<int>& neighbours : neighbour_sets)
+            reduction_stats.edges_before += neighbours.size();
+        reduction_stats.edges_before /= 2;
+        reduction_stats.edges_after = reduction_stats.edges_before;
+    }
+
+    bool IsWeighted()
+    {
+        return !vertex_weights.empty();
+    }
+
+    // Continues on the subgraph of the vertices that can be in a clique larger than the best one.
+    // The best clique is kept in original ids and Check() runs against the original graph.
+    void ReduceGraph()
+    {
+        CliqueReduction reduction = IsWeighted() ? ReduceForWeightedClique(neighbour_sets, weights, best_weight)
+            : ReduceForClique(neighbour_sets, best_clique.size());
+        reduction_stats.vertices_after = reduction.stats.vertices_after;
+        reduction_stats.edges_after = reduction.stats.edges_after;
+        ReplaceGraph(move(reduction.neighbour_sets), reduction.original_ids);
+    }
+
+    // Renumbers the vertices for locality (see relabel.h), the best clique stays in original ids
+    void RelabelVertices(VertexRelabelling relabelling)
+    {
+        if (relabelling == VertexRelabelling::None)
+            return;
+        vector<int> order = ComputeRelabelling(BuildCsrGraph(neighbour_sets), relabelling);
+        ReplaceGraph(RelabelNeighbourSets(neighbour_sets, order), order);
+    }
+
+    const ReductionStats& GetReductionStats()
+    {
+        return reduction_stats;
+    }
+
+    void FindClique(int randomization, int iterations)
+    {
+        static mt19937 generator(RunSeed());
+        for (int iteration = 0; iteration < iterations && !IsOptimal(); ++iteration)
+        {
+            vector<int> clique;
+            vector<int> candidates;
+            FillCandidates(candidates);
+            shuffle(candidates.begin(), candidates.end(), generator);
+            while (!candidates.empty())
+            {
+                OrderByWeight(candidates);
+                int last = candidates.size() - 1;
+                int rnd = GetRandom(0, min(randomization - 1, last));
+                int vertex = candidates[rnd];
+                clique.push_back(vertex);
+                for (int c = 0; c < candidates.size(); ++c)
+                {
+                    int candidate = candidates[c];
+                    if (neighbour_sets[vertex].count(candidate) == 0)
+                    {
+                        // Move the candidate to the end and pop it
+                        swap(candidates[c], candidates[candidates.size() - 1]);
+                        candidates.pop_back();
+                        --c;
+                    }
+                }
+                shuffle(candidates.begin(), candidates.end(), generator);
+            }
+            if (IsBetter(clique))
+            {
+                SetBestClique(clique);
+            }
+        }
+    }
+
+    void BasicGreedyRandomizedAlgorithm(int randomization, int iterations)
+    {
+        static mt19937 generator(RunSeed());
+
+        // Repeat the algorithm for the given number of iterations, or until the degeneracy bound is reached
+        for (int iteration = 0; iteration < iterations && !IsOptimal(); ++iteration)
+        {
+            vector<int> clique;
+            vector<int> candidates;
+
+            // Initialize the candidates vector
+            FillCandidates(candidates);
+
+            // Shuffle the candidates vector randomly
+            shuffle(candidates.begin(), candidates.end(), generator);
+
+            // Construct the clique, a weighted search picks among the `randomization` heaviest candidates
+            while (!candidates.empty())
+            {
+                OrderByWeight(candidates);
+                int last = candidates.size() - 1;
+                int rnd = GetRandom(0, min(randomization - 1, last));
+                int vertex = candidates[rnd];
+                clique.push_back(vertex);
+
+                // Remove vertices that are not adjacent to the last added vertex
+                for (int c = 0; c < candidates.size(); ++c)
+                {
+                    int candidate = candidates[c];
+                    if (neighbour_sets[vertex].count(candidate) == 0)
+                    {
+                        swap(candidates[c], candidates[candidates.size() - 1]);
+                        candidates.pop_back();
+                        --c;
+                    }
+                }
+
+                // Shuffle the candidates vector randomly again
+                shuffle(candidates.begin(), candidates.end(), generator);
+            }
+
+            // Update the best clique found so far
+            if (IsBetter(clique))
+            {
+                SetBestClique(clique);
+            }
+        }
+
+    }
+
+    const vector<int>& GetClique()
+    {
+        return best_clique;
+    }
+
+    // Clique weight, the size for an unweighted graph
+    long long GetCliqueWeight()
+    {
+        return best_weight;
+    }
+
+    bool Check()
+    {
+        const vector<unordered_set<int>>& graph = original_neighbour_sets.empty() ? neighbour_sets : original_neighbour_sets;
+        if (unique(best_clique.begin(), best_clique.end()) != best_clique.end())
+        {
+            cout << "Duplicated vertices in the clique\n";
+            return false;
+        }
+        for (int i : best_clique)
+        {
+            for (int j : best_clique)
+            {
+                if (i != j && graph[i].count(j) == 0)
+                {
+                    cout << "Returned subgraph is not a clique\n";
+                    return false;
+                }
+            }
+        }
+        if (CliqueWeight(vertex_weights, best_clique) != best_weight)
+        {
+            cout << "Clique weight does not match its vertices\n";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    // Switches to a graph whose vertex i is vertex ids[i] of the current one
+    void ReplaceGraph(vector<unordered_set<int>> graph, const vector<int>& ids)
+    {
+        vector<int> composed(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i)
+            composed[i] = original_ids[ids[i]];
+        if (original_neighbour_sets.empty())
+            original_neighbour_sets = move(neighbour_sets);
+        neighbour_sets = move(graph);
+        original_ids = move(composed);
+        weights = SelectVertexWeights(weights, ids);
+        cores = ComputeCoreDecomposition(BuildCsrGraph(neighbour_sets));
+    }
+
+    void SetBestClique(const vector<int>& clique)
+    {
+        best_clique.clear();
+        for (int v : clique)
+            best_clique.push_back(original_ids[v]);
+        best_weight = CliqueWeight(weights, clique);
+    }
+
+    bool IsBetter(const vector<int>& clique)
+    {
+        return IsWeighted() ? CliqueWeight(weights, clique) > best_weight : clique.size() > best_clique.size();
+    }
+
+    // Heaviest candidates first, so the restricted candidate list holds the `randomization` heaviest.
+    // The shuffle before it breaks ties at random; unweighted candidates stay as they are.
+    void OrderByWeight(vector<int>& candidates)
+    {
+        if (IsWeighted())
+            stable_sort(candidates.begin(), candidates.end(), [&](int a, int b) { return weights[a] > weights[b]; });
+    }
+
+    // k-core pruning: a vertex of a clique larger than the best one has core number at least its size.
+    // A heavier clique can be smaller, weighted graphs rely on ReduceGraph() instead.
+    void FillCandidates(vector<int>& candidates)
+    {
+        for (int i = 0; i < neighbour_sets.size(); ++i)
+        {
+            if (IsWeighted() || cores.core[i] >= int(best_clique.size()))
+                candidates.push_back(i);
+        }
+    }
+
+    // No clique of the (reduced) graph has more than degeneracy + 1 vertices
+    bool IsOptimal()
+    {
+        return !IsWeighted() && int(best_clique.size()) >= cores.degeneracy + 1;
+    }
+
+    vector<unordered_set<int>> neighbour_sets;
+    vector<unordered_set<int>> original_neighbour_sets;
+    vector<int> original_ids;
+    vector<int> best_clique;
+    long long best_weight = 0;
+    // Empty for an unweighted graph; vertex_weights is in file ids, weights in current ids
+    vector<int> vertex_weights;
+    vector<int> weights;
+    CoreDecomposition cores;
+    ReductionStats reduction_stats;
+};
+
+string GetProjectFolder() {
+    string path = __FILE__;
+    size_t found = path.find_last_of("\\/");
+
+    // get current project folder
+    string folderPath = path.substr(0, found);
+    return folderPath;
+}
+
+int main(int argc, char* argv[])
+{
+    VertexRelabelling relabelling = VertexRelabelling::None;
+    bool weighted = argc > 2 && string(argv[2]) == "weighted";
+    if ((argc > 1 && !ParseVertexRelabelling(argv[1], relabelling)) || (argc > 2 && !weighted))
+    {
+        cout << "Usage: maxclique [none|degree|degeneracy|rcm] [weighted]\n";
+        return 1;
+    }
+    string projFolder = GetProjectFolder();
+    string cliqueF = projFolder + "/../cliques/";
+
+    int iterations = 10000;
+    //cout << "Number of iterations: ";
+    //cin >> iterations;
+    int randomization = 10;
+    //cout << "Randomization: ";
+    //cin >> randomization;
+    // iterations on the full graph that give the incumbent for the k-core reduction
+    int reduction_iterations = 100;
+    vector<string> files = { 
+        cliqueF + "brock200_1.clq", cliqueF + "brock200_2.clq", cliqueF + "brock200_3.clq", cliqueF + "brock200_4.clq",
+        cliqueF + "brock400_1.clq", cliqueF + "brock400_2.clq", cliqueF + "brock400_3.clq", cliqueF + "brock400_4.clq",
+        cliqueF + "C125.9.clq", cliqueF + "DSJC1000_5.clq",
+        cliqueF + "gen200_p0.9_44.clq", cliqueF + "gen200_p0.9_55.clq",
+        cliqueF + "hamming8-4.clq",
+        cliqueF + "johnson16-2-4.clq", cliqueF + "johnson8-2-4.clq",
+        cliqueF + "keller4.clq",
+        cliqueF + "MANN_a27.clq", cliqueF + "MANN_a9.clq",
+        cliqueF + "p_hat1000-1.clq", cliqueF + "p_hat1000-2.clq", cliqueF + "p_hat1500-1.clq", cliqueF + "p_hat300-3.clq", cliqueF + "p_hat500-3.clq",
+        cliqueF + "san1000.clq", cliqueF + "sanr200_0.9.clq", cliqueF + "sanr400_0.7.clq"
+         };
+    files = SelectInstances(files);
+    ofstream fout(weighted ? "clique_weighted.csv" : "clique.csv");
+    fout << "File; Clique; Weight; Time (sec); Vertices; Reduced vertices; Edges; Reduced edges\n";
+    for (string file : files)
+    {
+        MaxCliqueProblem problem;
+        problem.ReadGraphFile(file, weighted);
+        clock_t start = clock();
+        problem.RelabelVertices(relabelling);
+        problem.BasicGreedyRandomizedAlgorithm(randomization, reduction_iterations);
+        problem.ReduceGraph();
+        problem.BasicGreedyRandomizedAlgorithm(randomization, iterations - reduction_iterations);
+        //problem.FindClique(randomization, iterations);
+        if (!problem.Check())
+        {
+            cout << "*** WARNING: incorrect clique ***\n";
+            fout << "*** WARNING: incorrect clique ***\n";
+        }
+        ReportResult(weighted ? "weighted_clique" : "clique", file, weighted ? problem.GetCliqueWeight() : problem.GetClique().size());
+        const ReductionStats& reduction = problem.GetReductionStats();
+        fout << file << "; " << problem.GetClique().size() << "; " << problem.GetCliqueWeight() << "; " << double(clock() - start) / CLOCKS_PER_SEC << "; "
+            << reduction.vertices_before << "; " << reduction.vertices_after << "; " << reduction.edges_before << "; " << reduction.edges_after << '\n';
+        cout << file << ", result - " << problem.GetClique().size() << ", weight - " << problem.GetCliqueWeight() << ", time - " << double(clock() - start) / CLOCKS_PER_SEC
+            << ", reduced to " << reduction.vertices_after << "/" << reduction.vertices_before << " vertices\n";
+    }
+    fout.close();
+    return 0;
+}
@@ -0,0 +1,533 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <map>
+#include <algorithm>
+#include <tuple>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <filesystem>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+using namespace std;
+namespace fs = std::filesystem;
+
+
+// One "run" line of a manifest: a solver with its arguments on one instance, repeated for every
+// seed `repetitions` times, each process killed after `timeout` seconds
+struct RunSpec
+{
+    string solver;
+    string instance;
+    vector<string> arguments;
+    vector<unsigned> seeds;
+    int repetitions = 1;
+    double timeout = 0;
+};
+
+// One solver process. The value is the last one the solver reported through MODERNOP_RESULTS.
+struct JobResult
+{
+    int spec = 0;
+    unsigned seed = 0;
+    int repetition = 0;
+    string status;
+    int exit_code = 0;
+    double wall_time = 0;
+    string problem;
+    bool has_value = false;
+    long long value = 0;
+};
+
+// Aggregate over all the jobs of one run line
+struct RunSummary
+{
+    int runs = 0;
+    int completed = 0;
+    int timeouts = 0;
+    int failures = 0;
+    string problem;
+    vector<double> wall_times;
+    vector<long long> values;
+    bool has_best_known = false;
+    long long best_known = 0;
+};
+
+// Runs a suite manifest. Lines, '#' starts a comment, relative paths are relative to the manifest:
+//   run <solver> <instance> <seeds> <repetitions> <timeout> [solver arguments...]
+//   best <problem> <instance file name> <value>
+//   include <manifest>
+// Seeds are a comma separated list of numbers and ranges ("1-5,42"). The solvers are started as
+// <solver dir>/<solver>/<solver> with MODERNOP_INSTANCES, MODERNOP_SEED and MODERNOP_RESULTS set,
+// stdin from /dev/null and a working directory of their own, so the CSV files they write do not
+// collide. Up to `workers` processes run at the same time.
+class SuiteRunner
+{
+public:
+    SuiteRunner(const string& solver_dir, const string& work_dir, int workers)
+        : solver_dir(solver_dir), work_dir(fs::absolute(work_dir).string()), workers(max(1, workers))
+    {
+    }
+
+    bool ReadManifest(const string& filename)
+    {
+        fs::path path = fs::absolute(filename);
+        ifstream fin(path);
+        if (!fin)
+        {
+            cerr << filename << ": cannot open\n";
+            return false;
+        }
+        string line;
+        for (int number = 1; getline(fin, line); ++number)
+        {
+            line = line.substr(0, line.find('#'));
+            stringstream line_input(line);
+            string command;
+            if (!(line_input >> command))
+                continue;
+            string where = path.string() + ":" + to_string(number) + ": ";
+            if (command == "include")
+            {
+                string other;
+                if (!(line_input >> other) || !ReadManifest(Resolve(path, other)))
+                {
+                    cerr << where << "bad include\n";
+                    return false;
+                }
+            }
+            else if (command == "best")
+            {
+                string problem, instance;
+                long long value;
+                if (!(line_input >> problem >> instance >> value))
+                {
+                    cerr << where << "expected: best <problem> <instance> <value>\n";
+                    return false;
+                }
+                best_known[problem + ";" + instance] = value;
+            }
+            else if (command == "run")
+            {
+                RunSpec spec;
+                string seeds;
+                if (!(line_input >> spec.solver >> spec.instance >> seeds >> spec.repetitions >> spec.timeout) ||
+                    !ParseSeeds(seeds, spec.seeds) || spec.repetitions < 1 || spec.timeout <= 0)
+                {
+                    cerr << where << "expected: run <solver> <instance> <seeds> <repetitions> <timeout> [arguments...]\n";
+                    return false;
+                }
+                spec.instance = Resolve(path, spec.instance);
+                for (string argument; line_input >> argument; )
+                    spec.arguments.push_back(argument);
+                specs.push_back(spec);
+            }
+            else
+            {
+                cerr << where << "unknown command " << command << '\n';
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Runs every job of every run line, at most `workers` at a time, in manifest order
+    void Run()
+    {
+        struct Running
+        {
+            pid_t pid;
+            JobResult result;
+            fs::path dir;
+            chrono::steady_clock::time_point start;
+            bool killed;
+        };
+        vector<JobResult> queue;
+        for (size_t s = 0; s < specs.size(); ++s)
+        {
+            for (unsigned seed : specs[s].seeds)
+            {
+                for (int r = 0; r < specs[s].repetitions; ++r)
+                {
+                    JobResult job;
+                    job.spec = s;
+                    job.seed = seed;
+                    job.repetition = r;
+                    queue.push_back(job);
+                }
+            }
+        }
+        fs::create_directories(work_dir);
+
+        vector<Running> running;
+        size_t next = 0, done = 0;
+        while (done < queue.size())
+        {
+            while (next < queue.size() && int(running.size()) < workers)
+            {
+                fs::path dir = fs::path(work_dir) / ("job" + to_string(next));
+                fs::remove_all(dir);
+                fs::create_directories(dir);
+                pid_t pid = Start(queue[next], dir);
+                if (pid < 0)
+                {
+                    // No process to wait for, the job fails right away with the reason in its log
+                    string error = strerror(errno);
+                    ofstream(dir / "log.txt") << "fork: " << error << '\n';
+                    JobResult result = queue[next];
+                    result.status = "failed";
+                    result.exit_code = -1;
+                    const RunSpec& spec = specs[result.spec];
+                    cout << spec.solver << " " << Join(spec.arguments) << " " << fs::path(spec.instance).filename().string() << " seed " << result.seed
+                        << ": failed, fork - " << error << ", log in " << dir.string() << endl;
+                    results.push_back(result);
+                    ++done;
+                }
+                else
+                {
+                    running.push_back({pid, queue[next], dir, chrono::steady_clock::now(), false});
+                }
+                ++next;
+            }
+
+            int status;
+            pid_t pid = waitpid(-1, &status, WNOHANG);
+            auto now = chrono::steady_clock::now();
+            if (pid <= 0)
+            {
+                for (Running& job : running)
+                {
+                    double elapsed = chrono::duration<double>(now - job.start).count();
+                    if (!job.killed && elapsed > specs[job.result.spec].timeout)
+                    {
+                        kill(-job.pid, SIGKILL);
+                        job.killed = true;
+                    }
+                }
+                this_thread::sleep_for(chrono::milliseconds(1));
+                continue;
+            }
+            auto it = find_if(running.begin(), running.end(), [&](const Running& job) { return job.pid == pid; });
+            if (it == running.end())
+                continue;
+            JobResult result = it->result;
+            result.wall_time = chrono::duration<double>(now - it->start).count();
+            if (it->killed)
+                result.status = "timeout";
+            else if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+                result.status = "ok";
+            else
+                result.status = "failed";
+            result.exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -WTERMSIG(status);
+            ReadReportedValue(it->dir / "results.txt", result);
+            if (result.status != "failed")
+                fs::remove_all(it->dir);
+            const RunSpec& spec = specs[result.spec];
+            cout << spec.solver << " " << Join(spec.arguments) << " " << fs::path(spec.instance).filename().string() << " seed " << result.seed
+                << ": " << result.status << ", time - " << result.wall_time;
+            if (result.has_value)
+                cout << ", " << result.problem << " - " << result.value;
+            cout << (result.status == "failed" ? ", log in " + it->dir.string() : "") << endl;
+            results.push_back(result);
+            running.erase(it);
+            ++done;
+        }
+        // Only the logs of failed runs are left
+        error_code error;
+        fs::remove(work_dir, error);
+        sort(results.begin(), results.end(), [](const JobResult& a, const JobResult& b) {
+            return make_tuple(a.spec, a.seed, a.repetition) < make_tuple(b.spec, b.seed, b.repetition);
+        });
+    }
+
+    void WriteJson(const string& filename)
+    {
+        ofstream fout(filename);
+        fout << "{\n  \"summary\": [";
+        for (size_t s = 0; s < specs.size(); ++s)
+        {
+            RunSummary summary = Summarize(s);
+            fout << (s ? ",\n" : "\n") << "    {" << SpecJson(s) << ", \"runs\": " << summary.runs << ", \"completed\": " << summary.completed
+                << ", \"timeouts\": " << summary.timeouts << ", \"failures\": " << summary.failures;
+            if (!summary.wall_times.empty())
+            {
+                fout << ", \"wall_time\": {\"median\": " << Median(summary.wall_times) << ", \"min\": " << summary.wall_times.front()
+                    << ", \"max\": " << summary.wall_times.back() << "}";
+            }
+            if (!summary.values.empty())
+            {
+                fout << ", \"problem\": " << Quote(summary.problem) << ", \"value\": {\"best\": " << BestValue(summary) << ", \"median\": "
+                    << Median(summary.values) << ", \"worst\": " << WorstValue(summary) << "}";
+                if (summary.has_best_known)
+                {
+                    fout << ", \"best_known\": " << summary.best_known << ", \"gap\": {\"best\": " << Gap(summary, BestValue(summary))
+                        << ", \"median\": " << Gap(summary, Median(summary.values)) << "}";
+                }
+            }
+            fout << "}";
+        }
+        fout << "\n  ],\n  \"runs\": [";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const JobResult& result = results[i];
+            fout << (i ? ",\n" : "\n") << "    {" << SpecJson(result.spec) << ", \"seed\": " << result.seed << ", \"repetition\": " << result.repetition
+                << ", \"status\": " << Quote(result.status) << ", \"exit_code\": " << result.exit_code << ", \"wall_time\": " << result.wall_time;
+            if (result.has_value)
+                fout << ", \"problem\": " << Quote(result.problem) << ", \"value\": " << result.value;
+            fout << "}";
+        }
+        fout << "\n  ]\n}\n";
+    }
+
+    // One row per run line, the same numbers as the summary of the JSON file; empty fields when
+    // no run completed or no best-known value is listed
+    void WriteCsv(const string& filename)
+    {
+        ofstream fout(filename);
+        fout << "solver,arguments,instance,problem,runs,completed,timeouts,failures,wall_median,wall_min,wall_max,"
+            << "value_best,value_median,value_worst,best_known,gap_best,gap_median\n";
+        for (size_t s = 0; s < specs.size(); ++s)
+        {
+            const RunSpec& spec = specs[s];
+            RunSummary summary = Summarize(s);
+            fout << spec.solver << ',' << Join(spec.arguments) << ',' << fs::path(spec.instance).filename().string() << ',' << summary.problem << ','
+                << summary.runs << ',' << summary.completed << ',' << summary.timeouts << ',' << summary.failures << ',';
+            if (!summary.wall_times.empty())
+                fout << Median(summary.wall_times) << ',' << summary.wall_times.front() << ',' << summary.wall_times.back() << ',';
+            else
+                fout << ",,,";
+            if (!summary.values.empty())
+                fout << BestValue(summary) << ',' << Median(summary.values) << ',' << WorstValue(summary) << ',';
+            else
+                fout << ",,,";
+            if (!summary.values.empty() && summary.has_best_known)
+                fout << summary.best_known << ',' << Gap(summary, BestValue(summary)) << ',' << Gap(summary, Median(summary.values));
+            else
+                fout << ",,";
+            fout << '\n';
+        }
+    }
+
+    bool Empty() const { return specs.empty(); }
+
+private:
+    static string Resolve(const fs::path& manifest, const string& file)
+    {
+        fs::path path(file);
+        return path.is_absolute() ? path.string() : (manifest.parent_path() / path).lexically_normal().string();
+    }
+
+    static bool ParseSeeds(const string& text, vector<unsigned>& seeds)
+    {
+        stringstream input(text);
+        string item;
+        while (getline(input, item, ','))
+        {
+            unsigned first, last;
+            char dash;
+            stringstream item_input(item);
+            if (!(item_input >> first))
+                return false;
+            last = first;
+            if (item_input >> dash && (dash != '-' || !(item_input >> last) || last < first))
+                return false;
+            for (unsigned seed = first; seed <= last; ++seed)
+                seeds.push_back(seed);
+        }
+        return !seeds.empty();
+    }
+
+    pid_t Start(const JobResult& job, const fs::path& dir)
+    {
+        const RunSpec& spec = specs[job.spec];
+        string binary = (fs::path(solver_dir) / spec.solver / spec.solver).string();
+        string results_file = (dir / "results.txt").string();
+        string log_file = (dir / "log.txt").string();
+        pid_t pid = fork();
+        if (pid < 0)
+            return pid;
+        if (pid != 0)
+        {
+            // Set on both sides, a timeout may come before the child got to it
+            setpgid(pid, pid);
+            return pid;
+        }
+
+        // Child: own process group, so a timeout kills whatever the solver started too
+        setpgid(0, 0);
+        if (chdir(dir.c_str()) != 0)
+            _exit(126);
+        int input = open("/dev/null", O_RDONLY);
+        int log = open(log_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (input < 0 || log < 0)
+            _exit(126);
+        dup2(input, STDIN_FILENO);
+        dup2(log, STDOUT_FILENO);
+        dup2(log, STDERR_FILENO);
+        setenv("MODERNOP_INSTANCES", spec.instance.c_str(), 1);
+        setenv("MODERNOP_SEED", to_string(job.seed).c_str(), 1);
+        setenv("MODERNOP_RESULTS", results_file.c_str(), 1);
+        vector<char*> argv;
+        argv.push_back(const_cast<char*>(binary.c_str()));
+        for (const string& argument : spec.arguments)
+            argv.push_back(const_cast<char*>(argument.c_str()));
+        argv.push_back(nullptr);
+        execv(binary.c_str(), argv.data());
+        cerr << binary << ": " << strerror(errno) << '\n';
+        _exit(127);
+    }
+
+    static void ReadReportedValue(const fs::path& filename, JobResult& result)
+    {
+        ifstream fin(filename);
+        string line;
+        while (getline(fin, line))
+        {
+            // "<problem>;<instance>;<value>", the instance may hold anything but a newline
+            size_t first = line.find(';'), last = line.rfind(';');
+            if (first == string::npos || first == last)
+                continue;
+            result.problem = line.substr(0, first);
+            result.value = atoll(line.c_str() + last + 1);
+            result.has_value = true;
+        }
+    }
+
+    RunSummary Summarize(int s) const
+    {
+        RunSummary summary;
+        for (const JobResult& result : results)
+        {
+            if (result.spec != s)
+                continue;
+            ++summary.runs;
+            summary.timeouts += result.status == "timeout";
+            summary.failures += result.status == "failed";
+            if (result.status != "ok")
+                continue;
+            ++summary.completed;
+            summary.wall_times.push_back(result.wall_time);
+            if (result.has_value)
+            {
+                summary.problem = result.problem;
+                summary.values.push_back(result.value);
+            }
+        }
+        sort(summary.wall_times.begin(), summary.wall_times.end());
+        sort(summary.values.begin(), summary.values.end());
+        auto known = best_known.find(summary.problem + ";" + fs::path(specs[s].instance).filename().string());
+        if (known != best_known.end())
+        {
+            summary.has_best_known = true;
+            summary.best_known = known->second;
+        }
+        return summary;
+    }
+
+    // Colourings are minimized, every other problem is maximized
+    static bool Minimized(const RunSummary& summary) { return summary.problem == "coloring"; }
+    static long long BestValue(const RunSummary& summary) { return Minimized(summary) ? summary.values.front() : summary.values.back(); }
+    static long long WorstValue(const RunSummary& summary) { return Minimized(summary) ? summary.values.back() : summary.values.front(); }
+
+    // Relative distance to the best-known value, positive when worse, negative for a new record
+    static double Gap(const RunSummary& summary, double value)
+    {
+        double known = summary.best_known;
+        if (known == 0)
+            return 0;
+        return (Minimized(summary) ? value - known : known - value) / known;
+    }
+
+    template <class T>
+    static double Median(const vector<T>& sorted)
+    {
+        size_t n = sorted.size();
+        return n % 2 ? double(sorted[n / 2]) : (double(sorted[n / 2 - 1]) + double(sorted[n / 2])) / 2;
+    }
+
+    static string Join(const vector<string>& arguments)
+    {
+        string result;
+        for (size_t i = 0; i < arguments.size(); ++i)
+            result += (i ? " " : "") + arguments[i];
+        return result;
+    }
+
+    static string Quote(const string& text)
+    {
+        string result = "\"";
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result + "\"";
+    }
+
+    string SpecJson(int s) const
+    {
+        const RunSpec& spec = specs[s];
+        return "\"solver\": " + Quote(spec.solver) + ", \"arguments\": " + Quote(Join(spec.arguments)) + ", \"instance\": " + Quote(spec.instance);
+    }
+
+    string solver_dir;
+    string work_dir;
+    int workers;
+    vector<RunSpec> specs;
+    map<string, long long> best_known;
+    vector<JobResult> results;
+};
+
+int main(int argc, char* argv[])
+{
+    // The solvers are built next to this project: <build>/suite/suite and <build>/<solver>/<solver>
+    string solver_dir = fs::absolute(argv[0]).parent_path().parent_path().string();
+    string output = "suite_results";
+    int workers = max(1u, thread::hardware_concurrency());
+    vector<string> manifests;
+    bool valid = true;
+    for (int i = 1; i < argc && valid; ++i)
+    {
+        string argument = argv[i];
+        if (argument == "-j" && i + 1 < argc)
+            workers = atoi(argv[++i]);
+        else if (argument == "-o" && i + 1 < argc)
+            output = argv[++i];
+        else if (argument == "--solvers" && i + 1 < argc)
+            solver_dir = argv[++i];
+        else if (!argument.empty() && argument[0] != '-')
+            manifests.push_back(argument);
+        else
+            valid = false;
+    }
+    if (!valid || manifests.empty() || workers < 1)
+    {
+        cout << "Usage: suite [-j workers] [-o output prefix] [--solvers build dir] manifest...\n";
+        return 1;
+    }
+
+    SuiteRunner runner(solver_dir, output + "_jobs", workers);
+    for (const string& manifest : manifests)
+    {
+        if (!runner.ReadManifest(manifest))
+            return 1;
+    }
+    if (runner.Empty())
+    {
+        cout << "No run lines in the manifest\n";
+        return 1;
+    }
+    runner.Run();
+    runner.WriteJson(output + ".json");
+    runner.WriteCsv(output + ".csv");
+    cout << "Results in " << output << ".json and " << output << ".csv\n";
+    return 0;
+}
@@ -1,255 +1,1125 @@
-#include <iostream>
-#include <fstream>
-#include <string>
-#include <vector>
-#include <sstream>
-#include <random>
-#include <algorithm>
-#include <set>
-#include <unordered_set>
-#include <time.h>
-using namespace std;
-
-class Vertex {
-public:
-    Vertex(int idx) : index(idx), color(-1), colored(false) {}
-
-    int GetIndex() const { return index; }
-    int GetColor() const { return color; }
-    int GetNumNeighbors() const { return neighborsnum; }
-    bool IsColored() const { return colored; }
-    const std::vector<int>& GetNeighbors() const { return neighbors; }
-
-    void SetColor(int c) { color = c; colored = true; }
-    void AddNeighbor(int neighbor_idx) { neighbors.push_back(neighbor_idx); }
-    void SetNumNeighbors(int n) { neighborsnum = n; }
-
-private:
-    int index;             
-    int neighborsnum;     
-    int color;            
-    bool colored;          
-    std::vector<int> neighbors;   
-};
-
-class ColoringProblem
-{
-public:
-    int GetRandom(int a, int b)
-    {
-        static mt19937 generator;
-        uniform_int_distribution<int> uniform(a, b);
-        return uniform(generator);
-    }
-
-    void ReadGraphFile(string filename)
-    {
-        ifstream fin(filename);
-        string line;
-        int vertices = 0, edges = 0;
-        while (getline(fin, line))
-        {
-            if (line[0] == 'c')
-            {
-                continue;
-            }
-
-            stringstream line_input(line);
-            char command;
-            if (line[0] == 'p')
-            {
-                string type;
-                line_input >> command >> type >> vertices >> edges;
-                neighbour_sets.resize(vertices);
-                colors.resize(vertices + 1);
-            }
-            else
-            {
-                int start, finish;
-                line_input >> command >> start >> finish;
-                // edges in DIMACS file can be repeated, but it is not a problem for our sets
-                neighbour_sets[start - 1].insert(finish - 1);
-                neighbour_sets[finish - 1].insert(start - 1);
-            }
-        }
-    }
-
-    void GreedyGraphColoring()
-    {
-        vector<int> uncolored_vertices(neighbour_sets.size());
-        for (size_t i = 0; i < uncolored_vertices.size(); ++i)
-            uncolored_vertices[i] = i;
-
-        while (!uncolored_vertices.empty())
-        {
-            int index = GetRandom(0, uncolored_vertices.size() - 1);
-            int vertex = uncolored_vertices[index];
-            int color = GetRandom(1, maxcolor);
-            for (int neighbour : neighbour_sets[vertex])
-            {
-                if (color == colors[neighbour])
-                {
-                    color = ++maxcolor;
-                    break;
-                }
-            }
-            colors[vertex] = color;
-            // Move the colored vertex to the end and pop it
-            swap(uncolored_vertices[uncolored_vertices.size() - 1], uncolored_vertices[index]);
-            uncolored_vertices.pop_back();
-        }
-    }
-
-    void WelshPowellGraphColoring()
-    {
-        sorted_vertices[0]->SetColor(1);
-
-        for (int i = 1; i < sorted_vertices.size(); i++) {
-            Vertex* v = sorted_vertices[i];
-            if (!v->IsColored()) {
-                // check if v is connected to any colored vertices
-                bool connected_to_colored = false;
-                for (int j = 0; j < v->GetNeighbors().size(); j++) {
-                    int neighbor_idx = v->GetNeighbors()[j];
-                    Vertex* neighbor = &vertices[neighbor_idx];
-                    if (neighbor->IsColored()) {
-                        connected_to_colored = true;
-                        break;
-                    }
-                }
-
-                if (!connected_to_colored) {
-                    // color of v = 1
-                    v->SetColor(1);
-                }
-                else {
-                    // find the smallest available color that is not being used by v's neighbors
-                    unordered_set<int> neighbor_colors;
-                    for (int j = 0; j < v->GetNeighbors().size(); j++) {
-                        int neighbor_idx = v->GetNeighbors()[j];
-                        Vertex* neighbor = &vertices[neighbor_idx];
-                        if (neighbor->IsColored()) {
-                            neighbor_colors.insert(neighbor->GetColor());
-                        }
-                    }
-
-                    int new_color = 1;
-                    while (neighbor_colors.count(new_color) > 0) {
-                        new_color++;
-                    }
-
-                    // set the color of v to the smallest available color
-                    v->SetColor(new_color);
-                    maxcolor = max(maxcolor, new_color);
-                }
-            }
-        }
-
-        for (int i = 0; i < vertices.size(); i++) {
-            colors[i] = vertices[i].GetColor();
-        }
-    }
-
-    bool Check()
-    {
-        for (size_t i = 0; i < neighbour_sets.size(); ++i)
-        {
-            if (colors[i] == 0)
-            {
-                cout << "Vertex " << i + 1 << " is not colored\n";
-                return false;
-            }
-            for (int neighbour : neighbour_sets[i])
-            {
-                if (colors[neighbour] == colors[i])
-                {
-                    cout << "Neighbour vertices " << i + 1 << ", " << neighbour + 1 << " have the same color\n";
-                    return false;
-                }
-            }
-        }
-        return true;
-    }
-
-    int GetNumberOfColors()
-    {
-        return maxcolor;
-    }
-
-    const vector<int>& GetColors()
-    {
-        return colors;
-    }
-
-    void ConstructVertexClassList(){
-        for (int i = 0; i < neighbour_sets.size(); i++) {
-            vertices.push_back(Vertex(i)); 
-            Vertex& v = vertices.back(); 
-            v.SetNumNeighbors(neighbour_sets[i].size()); 
-            for (int neighbor_idx : neighbour_sets[i]) {
-                v.AddNeighbor(neighbor_idx); 
-            }
-        }
-    }
-
-    void SortVertexClassObjects() {
-        for (Vertex& v : vertices) {
-            sorted_vertices.push_back(&v);
-        }
-        sort(sorted_vertices.begin(), sorted_vertices.end(), [](const Vertex* v1, const Vertex* v2) {
-            return v1->GetNumNeighbors() > v2->GetNumNeighbors();
-        });
-    }
-
-private:
-    vector<int> colors;
-    int maxcolor = 1;
-    vector<unordered_set<int>> neighbour_sets;
-    vector<Vertex> vertices;
-    vector<Vertex*> sorted_vertices;
-};
-
-string GetProjectFolder() {
-    string path = __FILE__;
-    size_t found = path.find_last_of("\\/");
-
-    // get current project folder
-    string folderPath = path.substr(0, found);
-    return folderPath;
-}
-
-int main()
-{
-    string projFolder = GetProjectFolder();
-    string graphF = projFolder + "\\..\\graphs\\";
-
-    vector<string> files = { graphF + "myciel3.col", graphF + "myciel7.col", 
-        graphF + "school1.col", graphF + "school1_nsh.col",
-        graphF + "anna.col", 
-        graphF + "miles1000.col", graphF + "miles1500.col",
-        graphF + "le450_5a.col", graphF + "le450_15b.col", 
-        graphF + "queen11_11.col"};
-    ofstream fout("color.csv");
-    fout << "Instance; Colors; Time (sec)\n";
-    cout << "Instance; Colors; Time (sec)\n";
-    for (string file : files)
-    {
-        ColoringProblem problem;
-        problem.ReadGraphFile(file);
-        clock_t start = clock();
-        problem.ConstructVertexClassList();
-        problem.SortVertexClassObjects();
-
-        //problem.GreedyGraphColoring();
-        problem.WelshPowellGraphColoring();
-        if (!problem.Check())
-        {
-            fout << "*** WARNING: incorrect coloring: ***\n";
-            cout << "*** WARNING: incorrect coloring: ***\n";
-        }
-        fout << file << "; " << problem.GetNumberOfColors() << "; " << double(clock() - start) / CLOCKS_PER_SEC << "; " << problem.GetColors()[0] << '\n';
-        cout << file << "; " << problem.GetNumberOfColors() << "; " << double(clock() - start) / CLOCKS_PER_SEC << '\n';
-    }
-    fout.close();
-    return 0;
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <unordered_set>
+#include <cstdint>
+#include <climits>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <tuple>
+#include <time.h>
+#include "csr_graph.h"
+#include "dimacs.h"
+#include "instances.h"
+#include "bucket_queue.h"
+#include "degeneracy.h"
+#include "relabel.h"
+#include "bit_ops.h"
+#include "first_fit.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+using namespace std;
+
+// TabuCol local search for a conflict-free k-coloring (Hertz, de Werra; tenure of Galinier, Hao).
+// gamma[v * k + c] counts neighbours of v that have color c, so the delta of moving v to c is
+// read in O(1) and a move updates only the rows of v's neighbours. Colors here are 0..k-1.
+class TabuColSearch
+{
+public:
+    TabuColSearch(const CsrGraph& graph, unsigned seed = 0) : graph(graph), generator(seed) {}
+
+    bool Run(vector<int>& coloring, int k, long long max_iterations, chrono::steady_clock::time_point deadline)
+    {
+        int n = graph.Size();
+        gamma.assign(size_t(n) * k, 0);
+        tabu.assign(size_t(n) * k, 0);
+        conflicting.clear();
+        conflict_position.assign(n, -1);
+
+        int conflicts = 0;
+        for (int v = 0; v < n; ++v)
+        {
+            for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+                ++gamma[size_t(v) * k + coloring[graph.targets[e]]];
+        }
+        for (int v = 0; v < n; ++v)
+        {
+            int own = gamma[size_t(v) * k + coloring[v]];
+            if (own > 0)
+            {
+                AddConflicting(v);
+                conflicts += own;
+            }
+        }
+        conflicts /= 2;
+
+        // A single color leaves no move to make
+        last_conflicts = conflicts;
+        if (k < 2)
+            return conflicts == 0;
+
+        int best_conflicts = conflicts;
+        for (long long iteration = 0; conflicts > 0 && iteration < max_iterations; ++iteration)
+        {
+            if ((iteration & 1023) == 0 && chrono::steady_clock::now() > deadline)
+                break;
+
+            int best_delta = INT_MAX, move_vertex = -1, move_color = -1, ties = 0;
+            for (int v : conflicting)
+            {
+                const int* row = &gamma[size_t(v) * k];
+                const long long* tabu_row = &tabu[size_t(v) * k];
+                int own = row[coloring[v]];
+                for (int c = 0; c < k; ++c)
+                {
+                    int delta = row[c] - own;
+                    if (c == coloring[v] || delta > best_delta)
+                        continue;
+                    // Aspiration: a tabu move is allowed if it leads to a new best
+                    if (tabu_row[c] > iteration && conflicts + delta >= best_conflicts)
+                        continue;
+                    if (delta < best_delta)
+                    {
+                        best_delta = delta;
+                        ties = 0;
+                    }
+                    // Reservoir sampling keeps a uniformly random move among the equal ones
+                    if (uniform_int_distribution<int>(0, ties++)(generator) == 0)
+                    {
+                        move_vertex = v;
+                        move_color = c;
+                    }
+                }
+            }
+            if (move_vertex == -1)
+            {
+                // Every move is tabu, take a random one
+                move_vertex = conflicting[uniform_int_distribution<int>(0, conflicting.size() - 1)(generator)];
+                move_color = (coloring[move_vertex] + uniform_int_distribution<int>(1, k - 1)(generator)) % k;
+                best_delta = gamma[size_t(move_vertex) * k + move_color] - gamma[size_t(move_vertex) * k + coloring[move_vertex]];
+            }
+
+            int old_color = coloring[move_vertex];
+            Move(coloring, move_vertex, move_color, k);
+            conflicts += best_delta;
+            best_conflicts = min(best_conflicts, conflicts);
+            int tenure = uniform_int_distribution<int>(0, 9)(generator) + int(0.6 * conflicting.size());
+            tabu[size_t(move_vertex) * k + old_color] = iteration + tenure;
+        }
+        last_conflicts = conflicts;
+        return conflicts == 0;
+    }
+
+    int GetConflicts() const { return last_conflicts; }
+
+private:
+    void AddConflicting(int v)
+    {
+        conflict_position[v] = conflicting.size();
+        conflicting.push_back(v);
+    }
+
+    void RemoveConflicting(int v)
+    {
+        int last = conflicting.back();
+        conflicting[conflict_position[v]] = last;
+        conflict_position[last] = conflict_position[v];
+        conflicting.pop_back();
+        conflict_position[v] = -1;
+    }
+
+    void Move(vector<int>& coloring, int v, int color, int k)
+    {
+        int old_color = coloring[v];
+        coloring[v] = color;
+        for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+        {
+            int u = graph.targets[e];
+            int* row = &gamma[size_t(u) * k];
+            if (--row[old_color] == 0 && coloring[u] == old_color)
+                RemoveConflicting(u);
+            if (++row[color] == 1 && coloring[u] == color)
+                AddConflicting(u);
+        }
+        bool now_conflicting = gamma[size_t(v) * k + color] > 0;
+        if (!now_conflicting && conflict_position[v] != -1)
+            RemoveConflicting(v);
+        else if (now_conflicting && conflict_position[v] == -1)
+            AddConflicting(v);
+    }
+
+    const CsrGraph& graph;
+    mt19937 generator;
+    vector<int> gamma;
+    vector<long long> tabu;
+    vector<int> conflicting;
+    vector<int> conflict_position;
+    int last_conflicts = 0;
+};
+
+// Per-thread state of the hybrid evolutionary coloring: its own TabuCol, generator and the
+// color class bitsets used by the crossover. Everything is sized for max_k colors up front.
+class EvolutionWorker
+{
+public:
+    EvolutionWorker(const CsrGraph& graph, int max_k, unsigned seed) : graph(graph), search(graph, seed), generator(seed),
+        words((graph.Size() + 63) / 64), child(graph.Size()), order(graph.Size()), counts(max_k),
+        classes(size_t(2) * max_k * words), remaining(words) {}
+
+    // Random order, every vertex takes the color least used among its already colored neighbours
+    void RandomColoring(int k)
+    {
+        int n = graph.Size();
+        for (int i = 0; i < n; ++i)
+        {
+            order[i] = i;
+            child[i] = -1;
+        }
+        shuffle(order.begin(), order.end(), generator);
+        for (int v : order)
+        {
+            fill(counts.begin(), counts.begin() + k, 0);
+            for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+            {
+                int c = child[graph.targets[e]];
+                if (c != -1)
+                    ++counts[c];
+            }
+            child[v] = min_element(counts.begin(), counts.begin() + k) - counts.begin();
+        }
+    }
+
+    // Greedy Partition Crossover: the child takes the largest remaining class of each parent in turn
+    void Crossover(const int* first, const int* second, int k)
+    {
+        int n = graph.Size();
+        fill(classes.begin(), classes.begin() + size_t(2) * k * words, 0);
+        for (int v = 0; v < n; ++v)
+        {
+            uint64_t bit = uint64_t(1) << (v % 64);
+            classes[size_t(first[v]) * words + v / 64] |= bit;
+            classes[(size_t(k) + second[v]) * words + v / 64] |= bit;
+            child[v] = -1;
+        }
+        fill(remaining.begin(), remaining.end(), 0);
+        for (int v = 0; v < n; ++v)
+            remaining[v / 64] |= uint64_t(1) << (v % 64);
+
+        const BitKernels& kernels = GetBitKernels();
+        for (int color = 0; color < k; ++color)
+        {
+            const uint64_t* parent = &classes[size_t(color % 2) * k * words];
+            int best_class = 0, best_size = -1;
+            for (int c = 0; c < k; ++c)
+            {
+                int size = kernels.intersection_count(parent + size_t(c) * words, remaining.data(), words);
+                if (size > best_size)
+                {
+                    best_size = size;
+                    best_class = c;
+                }
+            }
+            const uint64_t* chosen = parent + size_t(best_class) * words;
+            for (int w = 0; w < words; ++w)
+            {
+                for (uint64_t bits = chosen[w] & remaining[w]; bits != 0; bits &= bits - 1)
+                    child[w * 64 + CountTrailingZeros(bits)] = color;
+                remaining[w] &= ~chosen[w];
+            }
+        }
+
+        uniform_int_distribution<int> uniform(0, k - 1);
+        for (int v = 0; v < n; ++v)
+        {
+            if (child[v] == -1)
+                child[v] = uniform(generator);
+        }
+    }
+
+    int Improve(int k, long long iterations, chrono::steady_clock::time_point deadline)
+    {
+        search.Run(child, k, iterations, deadline);
+        return search.GetConflicts();
+    }
+
+    mt19937& GetGenerator() { return generator; }
+
+    const vector<int>& GetChild() const { return child; }
+
+private:
+    const CsrGraph& graph;
+    TabuColSearch search;
+    mt19937 generator;
+    int words;
+    vector<int> child;
+    vector<int> order;
+    vector<int> counts;
+    vector<uint64_t> classes;
+    vector<uint64_t> remaining;
+};
+
+enum class VertexOrdering
+{
+    LargestFirst,
+    SmallestLast,
+    IncidenceDegree
+};
+
+class ColoringProblem
+{
+public:
+    int GetRandom(int a, int b)
+    {
+        static mt19937 generator(RunSeed());
+        uniform_int_distribution<int> uniform(a, b);
+        return uniform(generator);
+    }
+
+    void ReadGraphFile(string filename)
+    {
+        DimacsGraph graph = ReadDimacsGraph(filename);
+        neighbour_sets = move(graph.neighbour_sets);
+        int vertices = neighbour_sets.size();
+        colors.resize(vertices + 1);
+        original_ids.resize(vertices);
+        iota(original_ids.begin(), original_ids.end(), 0);
+    }
+
+    // Renumbers the vertices for locality (see relabel.h) before ConstructVertexArrays().
+    // GetColors() and the Check() messages stay in the ids of the file.
+    void RelabelVertices(VertexRelabelling relabelling)
+    {
+        if (relabelling == VertexRelabelling::None)
+            return;
+        vector<int> order = ComputeRelabelling(BuildCsrGraph(neighbour_sets), relabelling);
+        neighbour_sets = RelabelNeighbourSets(neighbour_sets, order);
+        for (int& id : order)
+            id = original_ids[id];
+        original_ids = move(order);
+    }
+
+    void GreedyGraphColoring()
+    {
+        vector<int> uncolored_vertices(neighbour_sets.size());
+        for (size_t i = 0; i < uncolored_vertices.size(); ++i)
+            uncolored_vertices[i] = i;
+
+        while (!uncolored_vertices.empty())
+        {
+            int index = GetRandom(0, uncolored_vertices.size() - 1);
+            int vertex = uncolored_vertices[index];
+            int color = GetRandom(1, maxcolor);
+            for (int neighbour : neighbour_sets[vertex])
+            {
+                if (color == colors[neighbour])
+                {
+                    color = ++maxcolor;
+                    break;
+                }
+            }
+            colors[vertex] = color;
+            // Move the colored vertex to the end and pop it
+            swap(uncolored_vertices[uncolored_vertices.size() - 1], uncolored_vertices[index]);
+            uncolored_vertices.pop_back();
+        }
+    }
+
+    void WelshPowellGraphColoring()
+    {
+        FirstFitKernel first_fit(max_degree);
+        fill(colors.begin(), colors.end(), 0);
+        for (int v : order)
+        {
+            int color = first_fit.Choose(graph.targets.data() + graph.offsets[v], degree[v], colors.data());
+            colors[v] = color;
+            maxcolor = max(maxcolor, color);
+        }
+    }
+
+    void DSaturGraphColoring()
+    {
+        int n = graph.Size();
+        vector<int> uncolored_degree(degree);
+        vector<int> saturation(n, 0);
+
+        // One max-heap of (degree in the uncolored subgraph, push order, vertex) per saturation, so the
+        // top entry of the highest non-empty level is Brelaz's choice, ties go to the latest change.
+        // Keys only change along edges, every change pushes a new entry and the outdated ones are
+        // dropped when they reach the top: O((n + m) log n) in total and n + m entries at most.
+        vector<vector<tuple<int, int, int>>> levels(max_degree + 1);
+        int pushes = 0;
+        for (int i = 0; i < n; ++i)
+            levels[0].push_back({ uncolored_degree[i], pushes++, i });
+        make_heap(levels[0].begin(), levels[0].end());
+        int top = 0;
+
+        // A vertex can only take colors 1..degree + 1, so its row of forbidden bits is sized from its
+        // own degree. Larger neighbour colors only add to the saturation, they are kept in the vertex's
+        // slots of the edge array and looked up by a scan shorter than its degree.
+        vector<size_t> row_start(size_t(n) + 1, 0);
+        for (int i = 0; i < n; ++i)
+            row_start[i + 1] = row_start[i] + size_t(degree[i] + 1) / 64 + 1;
+        vector<uint64_t> forbidden(row_start[n], 0);
+        vector<int> large_colors(graph.targets.size());
+        vector<int> large_count(n, 0);
+
+        maxcolor = 0;
+        for (int colored = 0; colored < n; ++colored)
+        {
+            int vertex;
+            while (true)
+            {
+                vector<tuple<int, int, int>>& level = levels[top];
+                if (level.empty())
+                {
+                    --top;
+                    continue;
+                }
+                pop_heap(level.begin(), level.end());
+                auto [key, tie, u] = level.back();
+                level.pop_back();
+                if (colors[u] == 0 && saturation[u] == top && uncolored_degree[u] == key)
+                {
+                    vertex = u;
+                    break;
+                }
+            }
+
+            const uint64_t* row = &forbidden[row_start[vertex]];
+            int word = 0;
+            while (row[word] == ~uint64_t(0))
+                ++word;
+            int color = word * 64 + CountTrailingZeros(~row[word]) + 1;
+            colors[vertex] = color;
+            maxcolor = max(maxcolor, color);
+
+            uint64_t bit = uint64_t(1) << ((color - 1) % 64);
+            for (int e = graph.offsets[vertex]; e < graph.offsets[vertex + 1]; ++e)
+            {
+                int neighbour = graph.targets[e];
+                if (colors[neighbour] != 0)
+                    continue;
+                if (color <= degree[neighbour] + 1)
+                {
+                    uint64_t& bits = forbidden[row_start[neighbour] + (color - 1) / 64];
+                    if ((bits & bit) == 0)
+                    {
+                        bits |= bit;
+                        ++saturation[neighbour];
+                    }
+                }
+                else
+                {
+                    int* slots = &large_colors[graph.offsets[neighbour]];
+                    if (find(slots, slots + large_count[neighbour], color) == slots + large_count[neighbour])
+                    {
+                        slots[large_count[neighbour]++] = color;
+                        ++saturation[neighbour];
+                    }
+                }
+                --uncolored_degree[neighbour];
+                levels[saturation[neighbour]].push_back({ uncolored_degree[neighbour], pushes++, neighbour });
+                push_heap(levels[saturation[neighbour]].begin(), levels[saturation[neighbour]].end());
+                top = max(top, saturation[neighbour]);
+            }
+        }
+    }
+
+    void RLFGraphColoring()
+    {
+        int n = graph.Size();
+        int words = (n + 63) / 64;
+        vector<uint64_t> adjacency(size_t(n) * words, 0);
+        for (int i = 0; i < n; ++i)
+        {
+            for (int e = graph.offsets[i]; e < graph.offsets[i + 1]; ++e)
+                adjacency[size_t(i) * words + graph.targets[e] / 64] |= uint64_t(1) << (graph.targets[e] % 64);
+        }
+
+        // uncolored - all vertices without a color, candidates - uncolored vertices that can still
+        // join the current class, excluded - uncolored vertices adjacent to the current class
+        vector<uint64_t> uncolored(words, 0), candidates(words), excluded(words);
+        const BitKernels& kernels = GetBitKernels();
+        for (int i = 0; i < n; ++i)
+            uncolored[i / 64] |= uint64_t(1) << (i % 64);
+
+        maxcolor = 0;
+        int remaining = n;
+        while (remaining > 0)
+        {
+            ++maxcolor;
+            candidates = uncolored;
+            fill(excluded.begin(), excluded.end(), 0);
+
+            // The class starts from the vertex with the most uncolored neighbours
+            int vertex = -1, best = -1;
+            for (int w = 0; w < words; ++w)
+            {
+                for (uint64_t bits = candidates[w]; bits != 0; bits &= bits - 1)
+                {
+                    int u = w * 64 + CountTrailingZeros(bits);
+                    int degree = kernels.intersection_count(&adjacency[size_t(u) * words], candidates.data(), words);
+                    if (degree > best)
+                    {
+                        best = degree;
+                        vertex = u;
+                    }
+                }
+            }
+
+            while (vertex != -1)
+            {
+                colors[vertex] = maxcolor;
+                --remaining;
+                const uint64_t* row = &adjacency[size_t(vertex) * words];
+                uncolored[vertex / 64] &= ~(uint64_t(1) << (vertex % 64));
+                candidates[vertex / 64] &= ~(uint64_t(1) << (vertex % 64));
+                for (int w = 0; w < words; ++w)
+                {
+                    excluded[w] |= candidates[w] & row[w];
+                    candidates[w] &= ~row[w];
+                }
+
+                // Next vertex has the most neighbours among the excluded ones,
+                // ties go to the one with the fewest neighbours among the candidates
+                vertex = -1;
+                int best_excluded = -1, best_candidates = 0;
+                for (int w = 0; w < words; ++w)
+                {
+                    for (uint64_t bits = candidates[w]; bits != 0; bits &= bits - 1)
+                    {
+                        int u = w * 64 + CountTrailingZeros(bits);
+                        const uint64_t* u_row = &adjacency[size_t(u) * words];
+                        int in_excluded = kernels.intersection_count(u_row, excluded.data(), words);
+                        if (in_excluded < best_excluded)
+                            continue;
+                        int in_candidates = kernels.intersection_count(u_row, candidates.data(), words);
+                        if (in_excluded > best_excluded || in_candidates < best_candidates)
+                        {
+                            best_excluded = in_excluded;
+                            best_candidates = in_candidates;
+                            vertex = u;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Improves the current coloring: drops the highest color class onto the others and runs TabuCol
+    // until the conflicts are gone, then repeats with one color less. max_iterations limits every
+    // attempt, time_limit (seconds) the whole improvement. Each new best k goes to on_improvement.
+    void TabuColImprove(long long max_iterations, double time_limit, const function<void(int)>& on_improvement)
+    {
+        auto deadline = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(time_limit));
+        int n = graph.Size();
+        TabuColSearch search(graph, RunSeed(0));
+        vector<int> coloring(n), trial(n);
+        for (int i = 0; i < n; ++i)
+            coloring[i] = colors[i] - 1;
+
+        vector<int> counts;
+        for (int k = maxcolor - 1; k >= 2; --k)
+        {
+            // Vertices of the dropped class take the color least used among their neighbours
+            trial = coloring;
+            for (int v = 0; v < n; ++v)
+            {
+                if (trial[v] != k)
+                    continue;
+                counts.assign(k, 0);
+                for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+                {
+                    int c = trial[graph.targets[e]];
+                    if (c < k)
+                        ++counts[c];
+                }
+                trial[v] = min_element(counts.begin(), counts.end()) - counts.begin();
+            }
+
+            if (!search.Run(trial, k, max_iterations, deadline))
+                break;
+            swap(coloring, trial);
+            for (int i = 0; i < n; ++i)
+                colors[i] = coloring[i] + 1;
+            maxcolor = k;
+            on_improvement(k);
+        }
+    }
+
+    // Iterated greedy (Culberson): recolors first-fit with the vertices grouped by their current
+    // color class, so the number of colors never grows. Classes are ordered in reverse, largest
+    // first or at random, in turn; vertices keep their previous order inside a class. Stops after
+    // max_stale_rounds rounds without fewer colors. The buffers are allocated once for all rounds.
+    void IteratedGreedyImprove(int max_stale_rounds, const function<void(int)>& on_improvement)
+    {
+        static mt19937 generator(RunSeed());
+        int n = graph.Size();
+        vector<int> order(n), next_order(n);
+        for (int i = 0; i < n; ++i)
+            order[i] = i;
+        vector<int> class_order(maxcolor + 1), class_rank(maxcolor + 1), class_start(maxcolor + 2);
+        FirstFitKernel first_fit(max_degree);
+
+        for (int round = 0, stale = 0; stale < max_stale_rounds; ++round)
+        {
+            int k = maxcolor;
+            class_order.resize(k);
+            for (int c = 0; c < k; ++c)
+                class_order[c] = c + 1;
+            switch (round % 3)
+            {
+            case 0:
+                reverse(class_order.begin(), class_order.end());
+                break;
+            case 1:
+                fill(class_start.begin(), class_start.end(), 0);
+                for (int v = 0; v < n; ++v)
+                    ++class_start[colors[v]];
+                stable_sort(class_order.begin(), class_order.end(), [&](int a, int b) { return class_start[a] > class_start[b]; });
+                break;
+            default:
+                shuffle(class_order.begin(), class_order.end(), generator);
+                break;
+            }
+
+            // Stable counting sort of the previous order by the rank of each vertex's class
+            for (int r = 0; r < k; ++r)
+                class_rank[class_order[r]] = r;
+            fill(class_start.begin(), class_start.end(), 0);
+            for (int v = 0; v < n; ++v)
+                ++class_start[class_rank[colors[v]] + 1];
+            for (int r = 0; r < k; ++r)
+                class_start[r + 1] += class_start[r];
+            for (int v : order)
+                next_order[class_start[class_rank[colors[v]]]++] = v;
+            swap(order, next_order);
+
+            for (int v : order)
+                colors[v] = 0;
+            int new_k = 0;
+            for (int v : order)
+            {
+                int color = first_fit.Choose(graph.targets.data() + graph.offsets[v], degree[v], colors.data());
+                colors[v] = color;
+                new_k = max(new_k, color);
+            }
+
+            maxcolor = new_k;
+            if (new_k < k)
+            {
+                stale = 0;
+                on_improvement(new_k);
+            }
+            else
+            {
+                ++stale;
+            }
+        }
+    }
+
+    // Hybrid evolutionary algorithm (Galinier, Hao) looking for a coloring with fewer colors than the
+    // current one. Every generation each worker thread crosses two random parents with GPX, improves
+    // the child with tabu_iterations of TabuCol and the child replaces the worse parent. The population
+    // and the worker buffers are allocated once and reused for every k.
+    void HybridEvolutionaryImprove(int population_size, int threads, long long tabu_iterations, double time_limit,
+        const function<void(int)>& on_improvement)
+    {
+        auto deadline = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(time_limit));
+        int n = graph.Size();
+        int max_k = maxcolor - 1;
+        if (max_k < 2 || population_size < 2)
+            return;
+        threads = max(1, threads);
+
+        vector<EvolutionWorker> workers;
+        workers.reserve(threads);
+        for (int t = 0; t < threads; ++t)
+            workers.emplace_back(graph, max_k, RunSeed(0) + t + 1);
+        vector<int> population(size_t(population_size) * n);
+        vector<int> population_conflicts(population_size);
+        vector<pair<int, int>> parents(threads);
+        vector<int> child_conflicts(threads);
+        vector<char> replaced_now(population_size);
+        vector<int> candidate(colors.size(), 0);
+        ThreadPool pool(threads);
+
+        for (int k = max_k; k >= 2 && chrono::steady_clock::now() < deadline; --k)
+        {
+            for (int t = 0; t < threads; ++t)
+            {
+                pool.Submit([&, t, k] {
+                    for (int i = t; i < population_size; i += threads)
+                    {
+                        workers[t].RandomColoring(k);
+                        population_conflicts[i] = workers[t].Improve(k, tabu_iterations, deadline);
+                        copy(workers[t].GetChild().begin(), workers[t].GetChild().end(), population.begin() + size_t(i) * n);
+                    }
+                });
+            }
+            pool.Wait();
+
+            int solved = min_element(population_conflicts.begin(), population_conflicts.end()) - population_conflicts.begin();
+            while (population_conflicts[solved] > 0 && chrono::steady_clock::now() < deadline)
+            {
+                for (int t = 0; t < threads; ++t)
+                {
+                    pool.Submit([&, t, k] {
+                        uniform_int_distribution<int> uniform(0, population_size - 1);
+                        int first = uniform(workers[t].GetGenerator()), second;
+                        do
+                        {
+                            second = uniform(workers[t].GetGenerator());
+                        } while (second == first);
+                        parents[t] = { first, second };
+                        workers[t].Crossover(&population[size_t(first) * n], &population[size_t(second) * n], k);
+                        child_conflicts[t] = workers[t].Improve(k, tabu_iterations, deadline);
+                    });
+                }
+                pool.Wait();
+
+                // Workers may have drawn the same parent, then the best of their children keeps the slot
+                fill(replaced_now.begin(), replaced_now.end(), 0);
+                for (int t = 0; t < threads; ++t)
+                {
+                    int replaced = population_conflicts[parents[t].first] >= population_conflicts[parents[t].second] ? parents[t].first : parents[t].second;
+                    if (replaced_now[replaced] && child_conflicts[t] >= population_conflicts[replaced])
+                        continue;
+                    replaced_now[replaced] = 1;
+                    population_conflicts[replaced] = child_conflicts[t];
+                    copy(workers[t].GetChild().begin(), workers[t].GetChild().end(), population.begin() + size_t(replaced) * n);
+                }
+                solved = min_element(population_conflicts.begin(), population_conflicts.end()) - population_conflicts.begin();
+            }
+            if (population_conflicts[solved] > 0)
+                break;
+
+            // The current coloring is kept unless the new one checks out
+            for (int i = 0; i < n; ++i)
+                candidate[i] = population[size_t(solved) * n + i] + 1;
+            if (!Check(candidate))
+                break;
+            copy(candidate.begin(), candidate.end(), colors.begin());
+            maxcolor = k;
+            on_improvement(k);
+        }
+    }
+
+    // Jones-Plassmann coloring: in every round the uncolored vertices whose random priority beats
+    // all their uncolored neighbours form an independent set and take their first-fit color in
+    // parallel. Vertex ranges are split on 64-vertex boundaries, so each thread owns whole words of
+    // the per-round selection bitmap and no atomics are needed. The coloring depends only on the
+    // seed, not on the number of threads. Returns the number of rounds.
+    int JonesPlassmannGraphColoring(int threads, unsigned seed = 0)
+    {
+        int n = graph.Size();
+        threads = max(1, threads);
+        vector<int> priority(n);
+        iota(priority.begin(), priority.end(), 0);
+        mt19937 generator(seed);
+        shuffle(priority.begin(), priority.end(), generator);
+
+        int chunk = ((n + threads - 1) / threads + 63) / 64 * 64;
+        vector<uint64_t> selected((n + 63) / 64, 0);
+        vector<vector<int>> worklists(threads);
+        vector<FirstFitKernel> first_fit(threads, FirstFitKernel(max_degree));
+        vector<int> thread_maxcolor(threads, 0);
+        fill(colors.begin(), colors.end(), 0);
+
+        ThreadPool pool(threads);
+        for (int t = 0; t < threads; ++t)
+        {
+            pool.Submit([&, t] {
+                for (int v = t * chunk; v < min(n, (t + 1) * chunk); ++v)
+                    worklists[t].push_back(v);
+            });
+        }
+        pool.Wait();
+
+        int rounds = 0;
+        while (any_of(worklists.begin(), worklists.end(), [](const vector<int>& worklist) { return !worklist.empty(); }))
+        {
+            ++rounds;
+            for (int t = 0; t < threads; ++t)
+            {
+                pool.Submit([&, t] {
+                    for (int v : worklists[t])
+                    {
+                        bool local_max = true;
+                        for (int e = graph.offsets[v]; e < graph.offsets[v + 1] && local_max; ++e)
+                        {
+                            int u = graph.targets[e];
+                            local_max = colors[u] != 0 || priority[u] < priority[v];
+                        }
+                        if (local_max)
+                            selected[v / 64] |= uint64_t(1) << (v % 64);
+                    }
+                });
+            }
+            pool.Wait();
+
+            for (int t = 0; t < threads; ++t)
+            {
+                pool.Submit([&, t] {
+                    vector<int>& worklist = worklists[t];
+                    size_t kept = 0;
+                    for (int v : worklist)
+                    {
+                        uint64_t bit = uint64_t(1) << (v % 64);
+                        if ((selected[v / 64] & bit) == 0)
+                        {
+                            worklist[kept++] = v;
+                            continue;
+                        }
+                        selected[v / 64] &= ~bit;
+                        int color = first_fit[t].Choose(graph.targets.data() + graph.offsets[v], degree[v], colors.data());
+                        colors[v] = color;
+                        thread_maxcolor[t] = max(thread_maxcolor[t], color);
+                    }
+                    worklist.resize(kept);
+                });
+            }
+            pool.Wait();
+        }
+        maxcolor = *max_element(thread_maxcolor.begin(), thread_maxcolor.end());
+        return rounds;
+    }
+
+    // Check() split over threads by vertex ranges, reports the lowest offending vertex
+    bool ParallelCheck(int threads)
+    {
+        int n = graph.Size();
+        threads = max(1, threads);
+        int chunk = (n + threads - 1) / threads;
+        vector<int> bad_vertex(threads, -1), bad_neighbour(threads, -1);
+        ThreadPool pool(threads);
+        for (int t = 0; t < threads; ++t)
+        {
+            pool.Submit([&, t] {
+                for (int v = t * chunk; v < min(n, (t + 1) * chunk) && bad_vertex[t] == -1; ++v)
+                {
+                    if (colors[v] == 0)
+                        bad_vertex[t] = v;
+                    for (int e = graph.offsets[v]; e < graph.offsets[v + 1] && bad_vertex[t] == -1; ++e)
+                    {
+                        if (colors[graph.targets[e]] == colors[v])
+                        {
+                            bad_vertex[t] = v;
+                            bad_neighbour[t] = graph.targets[e];
+                        }
+                    }
+                }
+            });
+        }
+        pool.Wait();
+
+        for (int t = 0; t < threads; ++t)
+        {
+            if (bad_vertex[t] == -1)
+                continue;
+            if (bad_neighbour[t] == -1)
+                cout << "Vertex " << original_ids[bad_vertex[t]] + 1 << " is not colored\n";
+            else
+                cout << "Neighbour vertices " << original_ids[bad_vertex[t]] + 1 << ", " << original_ids[bad_neighbour[t]] + 1 << " have the same color\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool Check()
+    {
+        return Check(colors);
+    }
+
+    bool Check(const vector<int>& coloring)
+    {
+        for (size_t i = 0; i < neighbour_sets.size(); ++i)
+        {
+            if (coloring[i] == 0)
+            {
+                cout << "Vertex " << original_ids[i] + 1 << " is not colored\n";
+                return false;
+            }
+            for (int neighbour : neighbour_sets[i])
+            {
+                if (coloring[neighbour] == coloring[i])
+                {
+                    cout << "Neighbour vertices " << original_ids[i] + 1 << ", " << original_ids[neighbour] + 1 << " have the same color\n";
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    int GetNumberOfColors()
+    {
+        return maxcolor;
+    }
+
+    // Colors indexed by the vertex ids of the file
+    vector<int> GetColors()
+    {
+        vector<int> original_colors = colors;
+        for (size_t v = 0; v < original_ids.size(); ++v)
+            original_colors[original_ids[v]] = colors[v];
+        return original_colors;
+    }
+
+    // Flattens the neighbour sets into structure-of-arrays form: CSR offsets over one sorted target
+    // list and a degree array. Every coloring except the random greedy one runs on these arrays.
+    void ConstructVertexArrays()
+    {
+        graph = BuildCsrGraph(neighbour_sets);
+        int n = graph.Size();
+        degree.resize(n);
+        max_degree = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            degree[i] = graph.Degree(i);
+            max_degree = max(max_degree, degree[i]);
+        }
+    }
+
+    // Vertex order for the first-fit (Welsh-Powell) coloring, all strategies are O(n + m):
+    // largest first is a counting sort by degree, smallest last is the reversed degeneracy order
+    // (at most degeneracy + 1 colors), incidence degree repeatedly takes the vertex with the most
+    // already ordered neighbours.
+    void OrderVertices(VertexOrdering ordering)
+    {
+        int n = graph.Size();
+        order.resize(n);
+
+        vector<int> start(max_degree + 2, 0);
+        for (int v = 0; v < n; ++v)
+            ++start[max_degree - degree[v] + 1];
+        for (int d = 0; d <= max_degree; ++d)
+            start[d + 1] += start[d];
+        for (int v = 0; v < n; ++v)
+            order[start[max_degree - degree[v]]++] = v;
+        if (ordering == VertexOrdering::LargestFirst)
+            return;
+
+        if (ordering == VertexOrdering::SmallestLast)
+        {
+            CoreDecomposition cores = ComputeCoreDecomposition(graph);
+            reverse_copy(cores.order.begin(), cores.order.end(), order.begin());
+            return;
+        }
+
+        // Incidence degree: inserted from the smallest degree up, so ties go to the larger degree
+        BucketQueue queue(n, max_degree);
+        vector<int> incidence(n, 0);
+        for (int i = n - 1; i >= 0; --i)
+            queue.Insert(order[i], 0);
+        for (int i = 0; i < n; ++i)
+        {
+            int v = queue.PopMax();
+            order[i] = v;
+            for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+            {
+                int u = graph.targets[e];
+                if (queue.Contains(u))
+                    queue.ChangeKey(u, ++incidence[u]);
+            }
+        }
+    }
+
+private:
+    vector<int> colors;
+    int maxcolor = 1;
+    vector<unordered_set<int>> neighbour_sets;
+    CsrGraph graph;
+    vector<int> degree;
+    vector<int> order;
+    int max_degree = 0;
+    vector<int> original_ids;
+};
+
+string GetProjectFolder() {
+    string path = __FILE__;
+    size_t found = path.find_last_of("\\/");
+
+    // get current project folder
+    string folderPath = path.substr(0, found);
+    return folderPath;
+}
+
+enum class ColoringAlgorithm
+{
+    Greedy,
+    WelshPowell,
+    DSatur,
+    RLF,
+    JonesPlassmann
+};
+
+enum class ColoringImprovement
+{
+    None,
+    TabuCol,
+    HybridEvolutionary,
+    IteratedGreedy
+};
+
+bool ParseColoringImprovement(const string& name, ColoringImprovement& improvement)
+{
+    if (name == "none")
+        improvement = ColoringImprovement::None;
+    else if (name == "tabucol")
+        improvement = ColoringImprovement::TabuCol;
+    else if (name == "hea")
+        improvement = ColoringImprovement::HybridEvolutionary;
+    else if (name == "iteratedgreedy")
+        improvement = ColoringImprovement::IteratedGreedy;
+    else
+        return false;
+    return true;
+}
+
+bool ParseVertexOrdering(const string& name, VertexOrdering& ordering)
+{
+    if (name == "largestfirst")
+        ordering = VertexOrdering::LargestFirst;
+    else if (name == "smallestlast")
+        ordering = VertexOrdering::SmallestLast;
+    else if (name == "incidence")
+        ordering = VertexOrdering::IncidenceDegree;
+    else
+        return false;
+    return true;
+}
+
+bool ParseColoringAlgorithm(const string& name, ColoringAlgorithm& algorithm)
+{
+    if (name == "greedy")
+        algorithm = ColoringAlgorithm::Greedy;
+    else if (name == "welshpowell")
+        algorithm = ColoringAlgorithm::WelshPowell;
+    else if (name == "dsatur")
+        algorithm = ColoringAlgorithm::DSatur;
+    else if (name == "rlf")
+        algorithm = ColoringAlgorithm::RLF;
+    else if (name == "jp")
+        algorithm = ColoringAlgorithm::JonesPlassmann;
+    else
+        return false;
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    ColoringAlgorithm algorithm = ColoringAlgorithm::WelshPowell;
+    ColoringImprovement improvement = ColoringImprovement::None;
+    VertexOrdering ordering = VertexOrdering::LargestFirst;
+    VertexRelabelling relabelling = VertexRelabelling::None;
+    if ((argc > 1 && !ParseColoringAlgorithm(argv[1], algorithm)) ||
+        (argc > 2 && !ParseColoringImprovement(argv[2], improvement)) ||
+        (argc > 3 && !ParseVertexOrdering(argv[3], ordering)) ||
+        (argc > 4 && !ParseVertexRelabelling(argv[4], relabelling)))
+    {
+        cout << "Usage: vertexcolor [greedy|welshpowell|dsatur|rlf|jp] [none|tabucol|hea|iteratedgreedy] [largestfirst|smallestlast|incidence] [none|degree|degeneracy|rcm]\n";
+        return 1;
+    }
+    long long tabu_iterations = 1000000;
+    double improve_time_limit = 10.0;
+    int hea_population = 10;
+    long long hea_tabu_iterations = 20000;
+    int hea_threads = max(1u, thread::hardware_concurrency());
+    int greedy_stale_rounds = 1000;
+    int max_threads = max(1u, thread::hardware_concurrency());
+
+    string projFolder = GetProjectFolder();
+    string graphF = projFolder + "/../graphs/";
+
+    vector<string> files = { graphF + "myciel3.col", graphF + "myciel7.col", 
+        graphF + "school1.col", graphF + "school1_nsh.col",
+        graphF + "anna.col", 
+        graphF + "miles1000.col", graphF + "miles1500.col",
+        graphF + "le450_5a.col", graphF + "le450_15b.col", 
+        graphF + "queen11_11.col"};
+    files = SelectInstances(files);
+    ofstream fout("color.csv");
+    fout << "Instance; Colors; Time (sec)\n";
+    cout << "Instance; Colors; Time (sec)\n";
+    ofstream jp_out;
+    if (algorithm == ColoringAlgorithm::JonesPlassmann)
+    {
+        jp_out.open("color_jp.csv");
+        jp_out << "Instance; Threads; Colors; Rounds; Wall time (sec); Speedup\n";
+    }
+    for (string file : files)
+    {
+        ColoringProblem problem;
+        problem.ReadGraphFile(file);
+        clock_t start = clock();
+        problem.RelabelVertices(relabelling);
+        problem.ConstructVertexArrays();
+        switch (algorithm)
+        {
+        case ColoringAlgorithm::Greedy:
+            problem.GreedyGraphColoring();
+            break;
+        case ColoringAlgorithm::WelshPowell:
+            problem.OrderVertices(ordering);
+            problem.WelshPowellGraphColoring();
+            break;
+        case ColoringAlgorithm::DSatur:
+            problem.DSaturGraphColoring();
+            break;
+        case ColoringAlgorithm::RLF:
+            problem.RLFGraphColoring();
+            break;
+        case ColoringAlgorithm::JonesPlassmann:
+        {
+            // Same seed for every thread count, so only the wall time changes
+            double single_thread_time = 0;
+            for (int threads = 1; ; threads = min(threads * 2, max_threads))
+            {
+                auto wall_start = chrono::steady_clock::now();
+                int rounds = problem.JonesPlassmannGraphColoring(threads, RunSeed(0));
+                double wall_time = chrono::duration<double>(chrono::steady_clock::now() - wall_start).count();
+                if (!problem.ParallelCheck(threads))
+                    jp_out << "*** WARNING: incorrect coloring: ***\n";
+                if (threads == 1)
+                    single_thread_time = wall_time;
+                jp_out << file << "; " << threads << "; " << problem.GetNumberOfColors() << "; " << rounds << "; " << wall_time << "; " << single_thread_time / wall_time << '\n';
+                cout << file << ", threads - " << threads << ", rounds - " << rounds << ", speedup - " << single_thread_time / wall_time << '\n';
+                if (threads == max_threads)
+                    break;
+            }
+            break;
+        }
+        }
+        auto report_improvement = [&](int k) {
+            fout << file << "; " << k << "; " << double(clock() - start) / CLOCKS_PER_SEC << '\n';
+            fout.flush();
+        };
+        if (improvement == ColoringImprovement::TabuCol)
+            problem.TabuColImprove(tabu_iterations, improve_time_limit, report_improvement);
+        else if (improvement == ColoringImprovement::HybridEvolutionary)
+            problem.HybridEvolutionaryImprove(hea_population, hea_threads, hea_tabu_iterations, improve_time_limit, report_improvement);
+        else if (improvement == ColoringImprovement::IteratedGreedy)
+            problem.IteratedGreedyImprove(greedy_stale_rounds, report_improvement);
+        if (!problem.Check())
+        {
+            fout << "*** WARNING: incorrect coloring: ***\n";
+            cout << "*** WARNING: incorrect coloring: ***\n";
+        }
+        ReportResult("coloring", file, problem.GetNumberOfColors());
+        fout << file << "; " << problem.GetNumberOfColors() << "; " << double(clock() - start) / CLOCKS_PER_SEC << "; " << problem.GetColors()[0] << '\n';
+        cout << file << "; " << problem.GetNumberOfColors() << "; " << double(clock() - start) / CLOCKS_PER_SEC << '\n';
+    }
+    fout.close();
+    return 0;
 }
\ No newline at end of file